@@ -0,0 +1,19 @@
+#ifndef ALLOCATIONCOUNTER_H
+#define ALLOCATIONCOUNTER_H
+
+#include <cstdint>
+
+// Counting is compiled in only with the QTCLIENT_COUNT_ALLOCATIONS CMake option,
+// which replaces the global operator new for the whole process.
+namespace allocationcounter {
+struct Totals {
+    std::uint64_t allocations = 0;
+    std::uint64_t bytes = 0;
+};
+
+bool isEnabled();
+std::uint64_t allocationCount();
+Totals totals();
+}
+
+#endif
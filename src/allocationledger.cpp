@@ -0,0 +1,104 @@
+#include "allocationledger.h"
+
+namespace {
+constexpr AllocationLedger::MessageType shotCycleTypes[] = {
+    AllocationLedger::MessageType::Shoot,
+    AllocationLedger::MessageType::ShotResult,
+    AllocationLedger::MessageType::OpponentShot,
+    AllocationLedger::MessageType::Turn,
+};
+}
+
+AllocationLedger::Scope::Scope(AllocationLedger& ledger, MessageType type)
+    : owner(ledger)
+    , messageType(type)
+    , startTotals(allocationcounter::totals()) {
+}
+
+AllocationLedger::Scope::~Scope() {
+    const allocationcounter::Totals endTotals = allocationcounter::totals();
+    owner.record(messageType, {endTotals.allocations - startTotals.allocations, endTotals.bytes - startTotals.bytes});
+}
+
+void AllocationLedger::record(MessageType type, const allocationcounter::Totals& spent) {
+    Entry& target = entries[static_cast<int>(type)];
+    target.messages++;
+    target.allocations += spent.allocations;
+    target.bytes += spent.bytes;
+}
+
+void AllocationLedger::reset() {
+    entries.fill(Entry());
+}
+
+AllocationLedger::Entry AllocationLedger::gameTotal() const {
+    Entry total;
+    for (const Entry& current : entries) {
+        total.messages += current.messages;
+        total.allocations += current.allocations;
+        total.bytes += current.bytes;
+    }
+    return total;
+}
+
+double AllocationLedger::allocationsPerShotCycle() const {
+    const std::uint64_t shots = entry(MessageType::Shoot).messages;
+    if (shots == 0) {
+        return 0.0;
+    }
+    std::uint64_t allocations = 0;
+    for (MessageType type : shotCycleTypes) {
+        allocations += entry(type).allocations;
+    }
+    return static_cast<double>(allocations) / static_cast<double>(shots);
+}
+
+QString AllocationLedger::report() const {
+    const Entry total = gameTotal();
+    QString text = QString("Allocations this game: %1 (%2 bytes) over %3 messages, %4 per shot cycle")
+                       .arg(total.allocations)
+                       .arg(total.bytes)
+                       .arg(total.messages)
+                       .arg(allocationsPerShotCycle(), 0, 'f', 1);
+    if (allocationsPerShotCycle() > 0.0) {
+        text += "\n  Shot cycles are not allocation-free: sending a shot queues it in the transport, "
+                "and a board change schedules the next frame";
+    }
+    for (int index = 0; index < static_cast<int>(MessageType::Count); ++index) {
+        const Entry& current = entries[index];
+        if (current.messages == 0) {
+            continue;
+        }
+        text += QString("\n  %1: %2 messages, %3 allocations, %4 bytes")
+                    .arg(typeName(static_cast<MessageType>(index)))
+                    .arg(current.messages)
+                    .arg(current.allocations)
+                    .arg(current.bytes);
+    }
+    return text;
+}
+
+const char* AllocationLedger::typeName(MessageType type) {
+    switch (type) {
+        case MessageType::Lobby:
+            return "lobby";
+        case MessageType::Session:
+            return "session";
+        case MessageType::Board:
+            return "board";
+        case MessageType::Turn:
+            return "turn";
+        case MessageType::Shoot:
+            return "shoot";
+        case MessageType::ShotResult:
+            return "shot result";
+        case MessageType::OpponentShot:
+            return "opponent shot";
+        case MessageType::GameOver:
+            return "game over";
+        case MessageType::Other:
+        case MessageType::Count:
+            break;
+    }
+    return "other";
+}
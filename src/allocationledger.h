@@ -0,0 +1,46 @@
+#ifndef ALLOCATIONLEDGER_H
+#define ALLOCATIONLEDGER_H
+
+#include <QString>
+#include <array>
+
+#include "allocationcounter.h"
+
+class AllocationLedger {
+public:
+    enum class MessageType { Lobby, Session, Board, Turn, Shoot, ShotResult, OpponentShot, GameOver, Other, Count };
+
+    struct Entry {
+        std::uint64_t messages = 0;
+        std::uint64_t allocations = 0;
+        std::uint64_t bytes = 0;
+    };
+
+    class Scope {
+    public:
+        Scope(AllocationLedger& ledger, MessageType type);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        AllocationLedger& owner;
+        MessageType messageType;
+        allocationcounter::Totals startTotals;
+    };
+
+    void record(MessageType type, const allocationcounter::Totals& spent);
+    void reset();
+
+    const Entry& entry(MessageType type) const { return entries[static_cast<int>(type)]; }
+    Entry gameTotal() const;
+    double allocationsPerShotCycle() const;
+    QString report() const;
+
+    static const char* typeName(MessageType type);
+
+private:
+    std::array<Entry, static_cast<int>(MessageType::Count)> entries{};
+};
+
+#endif
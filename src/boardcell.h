@@ -0,0 +1,23 @@
+#ifndef BOARDCELL_H
+#define BOARDCELL_H
+
+#include <QAnyStringView>
+
+namespace boardcell {
+constexpr char empty = '.';
+constexpr char ship = 'S';
+constexpr char miss = 'o';
+constexpr char hit = 'X';
+
+inline char fromShotResult(QAnyStringView result) {
+    if (result == u"miss") {
+        return miss;
+    }
+    if (result == u"hit" || result == u"kill") {
+        return hit;
+    }
+    return 0;
+}
+}
+
+#endif
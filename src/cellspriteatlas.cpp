@@ -0,0 +1,46 @@
+#include "cellspriteatlas.h"
+
+#include <QPainter>
+
+#include "boardcell.h"
+
+namespace {
+constexpr int spriteCount = static_cast<int>(CellSpriteAtlas::Sprite::Count);
+const QColor spriteBorderColor{Qt::black};
+const QColor spriteFillColors[spriteCount] = {
+    QColor(Qt::white),
+    QColor(Qt::blue),
+    QColor(Qt::black),
+    QColor(Qt::red),
+    QColor(Qt::gray),
+};
+}
+
+CellSpriteAtlas::CellSpriteAtlas(int cellSize)
+    : spriteSize(cellSize)
+    , atlasImage(cellSize * spriteCount, cellSize, QImage::Format_ARGB32_Premultiplied) {
+    atlasImage.fill(Qt::transparent);
+    QPainter painter(&atlasImage);
+    for (int i = 0; i < spriteCount; ++i) {
+        const QRect rect = sourceRect(static_cast<Sprite>(i));
+        painter.fillRect(rect, spriteBorderColor);
+        painter.fillRect(rect.adjusted(1, 1, -1, -1), spriteFillColors[i]);
+    }
+}
+
+CellSpriteAtlas::Sprite CellSpriteAtlas::spriteFor(char cell, bool opponentBoard) {
+    switch (cell) {
+        case boardcell::ship:
+            return Sprite::Ship;
+        case boardcell::miss:
+            return Sprite::Miss;
+        case boardcell::hit:
+            return Sprite::Hit;
+        default:
+            return opponentBoard ? Sprite::Hidden : Sprite::Empty;
+    }
+}
+
+QRect CellSpriteAtlas::sourceRect(Sprite sprite) const {
+    return {static_cast<int>(sprite) * spriteSize, 0, spriteSize, spriteSize};
+}
@@ -0,0 +1,24 @@
+#ifndef CELLSPRITEATLAS_H
+#define CELLSPRITEATLAS_H
+
+#include <QImage>
+#include <QRect>
+
+class CellSpriteAtlas {
+public:
+    enum class Sprite { Empty, Ship, Miss, Hit, Hidden, Count };
+
+    explicit CellSpriteAtlas(int cellSize);
+
+    static Sprite spriteFor(char cell, bool opponentBoard);
+
+    const QImage& image() const { return atlasImage; }
+    QRect sourceRect(Sprite sprite) const;
+    int cellSize() const { return spriteSize; }
+
+private:
+    int spriteSize = 0;
+    QImage atlasImage;
+};
+
+#endif
@@ -0,0 +1,16 @@
+#include "commandencoder.h"
+
+CommandEncoder::CommandEncoder() {
+    for (int x = 0; x < SIZE; ++x) {
+        for (int y = 0; y < SIZE; ++y) {
+            shootCommands[x * SIZE + y] = QString("shoot %1 %2").arg(x).arg(y);
+        }
+    }
+}
+
+const QString& CommandEncoder::shoot(int x, int y) const {
+    if (x < 0 or x >= SIZE or y < 0 or y >= SIZE) {
+        return invalidCommand;
+    }
+    return shootCommands[x * SIZE + y];
+}
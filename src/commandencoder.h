@@ -0,0 +1,20 @@
+#ifndef COMMANDENCODER_H
+#define COMMANDENCODER_H
+
+#include <QString>
+#include <array>
+
+class CommandEncoder {
+public:
+    static constexpr int SIZE = 10;
+
+    CommandEncoder();
+
+    const QString& shoot(int x, int y) const;
+
+private:
+    std::array<QString, SIZE * SIZE> shootCommands;
+    QString invalidCommand;
+};
+
+#endif
@@ -0,0 +1,102 @@
+#include "directtransport.h"
+
+#include <QHash>
+
+namespace {
+QHash<QString, DirectTransportServer*>& serverRegistry() {
+    static QHash<QString, DirectTransportServer*> registry;
+    return registry;
+}
+}
+
+DirectTransport::DirectTransport(QObject* parent)
+    : Transport(parent) {
+}
+
+DirectTransport::~DirectTransport() {
+    detach(false);
+}
+
+void DirectTransport::connectPair(DirectTransport* first, DirectTransport* second) {
+    first->detach(true);
+    second->detach(true);
+    first->peer = second;
+    second->peer = first;
+    for (DirectTransport* transport : {first, second}) {
+        QMetaObject::invokeMethod(
+            transport, [transport] { emit transport->connected(); }, Qt::QueuedConnection);
+    }
+}
+
+void DirectTransport::open(const QUrl& url) {
+    DirectTransportServer* server = DirectTransportServer::find(url.host());
+    if (!server) {
+        QMetaObject::invokeMethod(
+            this, [this] { emit disconnected(); }, Qt::QueuedConnection);
+        return;
+    }
+    server->accept(this);
+}
+
+void DirectTransport::close() {
+    detach(true);
+}
+
+qint64 DirectTransport::sendTextMessage(const QString& message) {
+    if (peer.isNull()) {
+        return 0;
+    }
+    DirectTransport* receiver = peer.data();
+    QMetaObject::invokeMethod(
+        receiver, [receiver, message] { emit receiver->textMessageReceived(message); }, Qt::QueuedConnection);
+    return message.size();
+}
+
+void DirectTransport::detach(bool notifySelf) {
+    if (peer.isNull()) {
+        return;
+    }
+    DirectTransport* other = peer.data();
+    peer.clear();
+    other->peer.clear();
+    emit other->disconnected();
+    if (notifySelf) {
+        emit disconnected();
+    }
+}
+
+DirectTransportServer::DirectTransportServer(QObject* parent)
+    : QObject(parent) {
+}
+
+DirectTransportServer::~DirectTransportServer() {
+    close();
+}
+
+DirectTransportServer* DirectTransportServer::find(const QString& name) {
+    return serverRegistry().value(name.toLower(), nullptr);
+}
+
+bool DirectTransportServer::listen(const QString& name) {
+    if (name.isEmpty() or find(name)) {
+        return false;
+    }
+    close();
+    serverName = name.toLower();
+    serverRegistry().insert(serverName, this);
+    return true;
+}
+
+void DirectTransportServer::close() {
+    if (!serverName.isEmpty()) {
+        serverRegistry().remove(serverName);
+        serverName.clear();
+    }
+}
+
+DirectTransport* DirectTransportServer::accept(DirectTransport* client) {
+    auto* serverSide = new DirectTransport(this);
+    DirectTransport::connectPair(client, serverSide);
+    emit newConnection(serverSide);
+    return serverSide;
+}
@@ -0,0 +1,54 @@
+#ifndef DIRECTTRANSPORT_H
+#define DIRECTTRANSPORT_H
+
+#include <QPointer>
+
+#include "transport.h"
+
+class DirectTransportServer;
+
+class DirectTransport : public Transport {
+    Q_OBJECT
+
+public:
+    explicit DirectTransport(QObject* parent = nullptr);
+    ~DirectTransport() override;
+
+    static void connectPair(DirectTransport* first, DirectTransport* second);
+
+    void open(const QUrl& url) override;
+    void close() override;
+    bool isConnected() const override { return !peer.isNull(); }
+    qint64 sendTextMessage(const QString& message) override;
+
+private:
+    void detach(bool notifySelf);
+
+    QPointer<DirectTransport> peer;
+};
+
+class DirectTransportServer : public QObject {
+    Q_OBJECT
+
+public:
+    explicit DirectTransportServer(QObject* parent = nullptr);
+    ~DirectTransportServer() override;
+
+    static DirectTransportServer* find(const QString& name);
+
+    bool listen(const QString& name);
+    void close();
+    QString name() const { return serverName; }
+
+    signals:
+        void newConnection(DirectTransport* transport);
+
+private:
+    friend class DirectTransport;
+
+    DirectTransport* accept(DirectTransport* client);
+
+    QString serverName;
+};
+
+#endif
@@ -0,0 +1,34 @@
+#include "framescheduler.h"
+
+#include <QElapsedTimer>
+
+FrameScheduler::FrameScheduler(QObject* parent, int frameIntervalMs)
+    : QObject(parent) {
+    frameTimer.setSingleShot(true);
+    frameTimer.setTimerType(Qt::PreciseTimer);
+    frameTimer.setInterval(frameIntervalMs);
+    connect(&frameTimer, &QTimer::timeout, this, &FrameScheduler::deliverFrame);
+}
+
+FrameScheduler::~FrameScheduler() = default;
+
+void FrameScheduler::requestFrame() {
+    if (!frameTimer.isActive()) {
+        frameTimer.start();
+    }
+}
+
+void FrameScheduler::flush() {
+    if (!frameTimer.isActive()) {
+        return;
+    }
+    frameTimer.stop();
+    deliverFrame();
+}
+
+void FrameScheduler::deliverFrame() {
+    QElapsedTimer elapsed;
+    elapsed.start();
+    emit frameDue();
+    emit frameFinished(elapsed.nsecsElapsed());
+}
@@ -0,0 +1,30 @@
+#ifndef FRAMESCHEDULER_H
+#define FRAMESCHEDULER_H
+
+#include <QObject>
+#include <QTimer>
+
+class FrameScheduler : public QObject {
+    Q_OBJECT
+
+public:
+    explicit FrameScheduler(QObject* parent = nullptr, int frameIntervalMs = defaultFrameIntervalMs);
+    ~FrameScheduler() override;
+
+    void requestFrame();
+    void flush();
+    bool isFramePending() const { return frameTimer.isActive(); }
+
+    signals:
+        void frameDue();
+        void frameFinished(qint64 elapsedNs);
+
+private:
+    void deliverFrame();
+
+    static constexpr int defaultFrameIntervalMs = 16;
+
+    QTimer frameTimer;
+};
+
+#endif
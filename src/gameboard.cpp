@@ -1,12 +1,47 @@
 #include "gameboard.h"
 
+#include <QStringTokenizer>
+
+#include "boardcell.h"
+
 namespace {
 constexpr int сellSize = 30;
-constexpr auto playerShipStyle = "background-color: blue; border: 1px solid black;";
-constexpr auto playerEmptyCellStyle = "background-color: white; border: 1px solid black;";
-constexpr auto opponentDefaultStyle = "background-color: gray; border: 1px solid black;";
-constexpr auto missShootStyle = "background-color: black; border: 1px solid black;";
-constexpr auto winShootStyle = "background-color: red; border: 1px solid black;";
+const QString playerShipStyle = QStringLiteral("background-color: blue; border: 1px solid black;");
+const QString playerEmptyCellStyle = QStringLiteral("background-color: white; border: 1px solid black;");
+const QString opponentDefaultStyle = QStringLiteral("background-color: gray; border: 1px solid black;");
+const QString opponentInteractiveStyle = QStringLiteral("background-color: white; border: 1px solid black;");
+const QString missShootStyle = QStringLiteral("background-color: black; border: 1px solid black;");
+const QString winShootStyle = QStringLiteral("background-color: red; border: 1px solid black;");
+
+const QString& playerCellStyle(char cell) {
+    switch (cell) {
+        case boardcell::ship:
+            return playerShipStyle;
+        case boardcell::miss:
+            return missShootStyle;
+        case boardcell::hit:
+            return winShootStyle;
+        default:
+            return playerEmptyCellStyle;
+    }
+}
+
+const QString& opponentCellStyle(char cell, bool interactive) {
+    switch (cell) {
+        case boardcell::miss:
+            return missShootStyle;
+        case boardcell::hit:
+            return winShootStyle;
+        default:
+            return interactive ? opponentInteractiveStyle : opponentDefaultStyle;
+    }
+}
+
+void setStyleSheetIfChanged(QPushButton* cell, const QString& style) {
+    if (cell->styleSheet() != style) {
+        cell->setStyleSheet(style);
+    }
+}
 }
 
 GameBoard::GameBoard(QWidget* parent)
@@ -14,7 +49,10 @@ GameBoard::GameBoard(QWidget* parent)
     , playerWidgetFirst(new QWidget(parent))
     , opponentWidgetSecond(new QWidget(parent))
     , playerLayoutFirst(new QGridLayout(playerWidgetFirst))
-    , opponentLayoutSecond(new QGridLayout(opponentWidgetSecond)) {
+    , opponentLayoutSecond(new QGridLayout(opponentWidgetSecond))
+    , frameScheduler(new FrameScheduler(this)) {
+    connect(frameScheduler, &FrameScheduler::frameDue, this, &GameBoard::applyPendingUpdates);
+    connect(frameScheduler, &FrameScheduler::frameFinished, this, &GameBoard::frameRendered);
     playerBoardFirst.resize(SIZE, std::vector<char>(SIZE, '.'));
     opponentBoardSecond.resize(SIZE, std::vector<char>(SIZE, '.'));
     playerWidgetFirst->setVisible(false);
@@ -29,41 +67,63 @@ void GameBoard::cleanFiledForNewGame() {
     playerBoardFirst.resize(SIZE, std::vector<char>(SIZE, '.'));
     opponentBoardSecond.resize(SIZE, std::vector<char>(SIZE, '.'));
 
-    delete playerWidgetFirst;
-    delete opponentWidgetSecond;
+    detachWidgets();
 
-    playerWidgetFirst = new QWidget(qobject_cast<QWidget*>(parent()));
-    opponentWidgetSecond = new QWidget(qobject_cast<QWidget*>(parent()));
-    playerLayoutFirst = new QGridLayout(playerWidgetFirst);
-    opponentLayoutSecond = new QGridLayout(opponentWidgetSecond);
+    playerHash = 0;
+    opponentHash = 0;
 
     setupPlayerBoard();
     setupOpponentBoard();
+}
 
-    playerWidgetFirst->setVisible(false);
-    opponentWidgetSecond->setVisible(false);
+void GameBoard::detachWidgets() {
+    QWidget* owner = qobject_cast<QWidget*>(parent());
+    for (QWidget* widget : {playerWidgetFirst, opponentWidgetSecond}) {
+        widget->setVisible(false);
+        if (widget->parentWidget() != owner) {
+            widget->setParent(owner);
+        }
+    }
 }
 
 void GameBoard::parseAndSaveBoard(const QString& message) {
-    playerBoardFirst.clear();
-    playerBoardFirst.resize(SIZE, std::vector<char>(SIZE, '.'));
-    QStringList lines = message.split('\n', Qt::SkipEmptyParts);
-    bool boardStarted = false;
-    int row = 0;
+    readBoards(message);
+    showNewBoards(playerBoardFirst);
+}
 
-    for (const QString& line : lines) {
-        QString trimmedLine = line.trimmed();
-        if (trimmedLine.contains("Your board:")) {
-            boardStarted = true;
-            continue;
+void GameBoard::restoreBoards(const std::vector<std::vector<char>>& openingBoard,
+                              const std::vector<std::vector<char>>& playerBoard,
+                              const std::vector<std::vector<char>>& opponentBoard) {
+    const auto fullBoard = [](std::vector<std::vector<char>> board) {
+        board.resize(SIZE);
+        for (std::vector<char>& row : board) {
+            row.resize(SIZE, boardcell::empty);
         }
-        if (boardStarted and trimmedLine.length() == SIZE and row < SIZE) {
-            for (int col = 0; col < SIZE and col < trimmedLine.length(); ++col) {
-                playerBoardFirst[row][col] = trimmedLine[col].toLatin1();
-            }
-            row++;
+        return board;
+    };
+    const std::vector<std::vector<char>> opening = fullBoard(openingBoard);
+    playerBoardFirst = fullBoard(playerBoard);
+    opponentBoardSecond = fullBoard(opponentBoard);
+    playerHash = zobrist::boardHash(zobrist::Board::Player, playerBoardFirst);
+    opponentHash = zobrist::boardHash(zobrist::Board::Opponent, opponentBoardSecond);
+    showNewBoards(opening);
+    recordChanges(GameHistory::Board::Player, opening, playerBoardFirst);
+    recordChanges(GameHistory::Board::Opponent, {}, opponentBoardSecond);
+}
+
+std::vector<std::vector<char>> GameBoard::openingBoard() const {
+    const GameHistory::Cells opening = gameHistory.positionAt(0).player;
+    std::vector<std::vector<char>> board(SIZE, std::vector<char>(SIZE));
+    for (int i = 0; i < SIZE; ++i) {
+        for (int j = 0; j < SIZE; ++j) {
+            board[i][j] = opening[i * SIZE + j];
         }
     }
+    return board;
+}
+
+void GameBoard::showNewBoards(const std::vector<std::vector<char>>& openingBoard) {
+    gameHistory.start(openingBoard);
 
     setupPlayerBoard();
     setupOpponentBoard();
@@ -71,97 +131,174 @@ void GameBoard::parseAndSaveBoard(const QString& message) {
     opponentWidgetSecond->setVisible(true);
 }
 
-void GameBoard::setupPlayerBoard() {
-    while (QLayoutItem* item = playerLayoutFirst->takeAt(0)) {
-        if (item->widget()) {
-            delete item->widget();
-        }
-        delete item;
+void GameBoard::resyncBoards(const QString& message) {
+    const std::vector<std::vector<char>> previousPlayerBoard = playerBoardFirst;
+    const std::vector<std::vector<char>> previousOpponentBoard = opponentBoardSecond;
+    readBoards(message);
+    if (!message.contains(u"Opponent board:") and previousOpponentBoard.size() == SIZE) {
+        opponentBoardSecond = previousOpponentBoard;
+        opponentHash = zobrist::boardHash(zobrist::Board::Opponent, opponentBoardSecond);
     }
+    recordChanges(GameHistory::Board::Player, previousPlayerBoard, playerBoardFirst);
+    recordChanges(GameHistory::Board::Opponent, previousOpponentBoard, opponentBoardSecond);
+    playerDirtyCells.set();
+    opponentDirtyCells.set();
+    frameScheduler->requestFrame();
+}
 
+void GameBoard::recordChanges(GameHistory::Board board, const std::vector<std::vector<char>>& before,
+                              const std::vector<std::vector<char>>& after) {
     for (int i = 0; i < SIZE; ++i) {
         for (int j = 0; j < SIZE; ++j) {
-            QPushButton* cell = new QPushButton();
-            cell->setFixedSize(сellSize, сellSize);
-            if (playerBoardFirst[i][j] == 'S') {
-                cell->setStyleSheet(playerShipStyle);
-            } else {
-                cell->setStyleSheet(playerEmptyCellStyle);
+            const bool known = i < static_cast<int>(before.size()) and j < static_cast<int>(before[i].size());
+            if (after[i][j] != (known ? before[i][j] : boardcell::empty)) {
+                gameHistory.append(board, i, j, after[i][j]);
             }
-            cell->setEnabled(false);
-            playerLayoutFirst->addWidget(cell, i, j);
         }
     }
 }
 
-void GameBoard::setupOpponentBoard() {
-    while (QLayoutItem* item = opponentLayoutSecond->takeAt(0)) {
-        if (item->widget()) {
-            delete item->widget();
+void GameBoard::readBoards(const QString& message) {
+    playerBoardFirst.clear();
+    playerBoardFirst.resize(SIZE, std::vector<char>(SIZE, '.'));
+    opponentBoardSecond.clear();
+    opponentBoardSecond.resize(SIZE, std::vector<char>(SIZE, '.'));
+    std::vector<std::vector<char>>* board = nullptr;
+    int row = 0;
+
+    for (QStringView line : qTokenize(message, u'\n', Qt::SkipEmptyParts)) {
+        const QStringView trimmedLine = line.trimmed();
+        if (trimmedLine.contains(u"Your board:")) {
+            board = &playerBoardFirst;
+            row = 0;
+            continue;
+        }
+        if (trimmedLine.contains(u"Opponent board:")) {
+            board = &opponentBoardSecond;
+            row = 0;
+            continue;
+        }
+        if (board and trimmedLine.length() == SIZE and row < SIZE) {
+            for (int col = 0; col < SIZE and col < trimmedLine.length(); ++col) {
+                (*board)[row][col] = trimmedLine[col].toLatin1();
+            }
+            row++;
         }
-        delete item;
     }
 
-    for (int i = 0; i < SIZE; ++i) {
-        for (int j = 0; j < SIZE; ++j) {
-            QPushButton* cell = new QPushButton();
-            cell->setFixedSize(сellSize, сellSize);
-            cell->setStyleSheet(opponentDefaultStyle);
-            cell->setEnabled(false);
-            connect(cell, &QPushButton::clicked, this, [=]() { emit cellClicked(i, j); });
-            opponentLayoutSecond->addWidget(cell, i, j);
+    playerHash = zobrist::boardHash(zobrist::Board::Player, playerBoardFirst);
+    opponentHash = zobrist::boardHash(zobrist::Board::Opponent, opponentBoardSecond);
+}
+
+void GameBoard::setupPlayerBoard() {
+    if (playerCells.empty()) {
+        for (int i = 0; i < SIZE; ++i) {
+            for (int j = 0; j < SIZE; ++j) {
+                QPushButton* cell = new QPushButton();
+                cell->setFixedSize(сellSize, сellSize);
+                cell->setEnabled(false);
+                playerLayoutFirst->addWidget(cell, i, j);
+                playerCells.push_back(cell);
+            }
         }
     }
+    for (int index = 0; index < SIZE * SIZE; ++index) {
+        setStyleSheetIfChanged(playerCells[index], playerCellStyle(playerBoardFirst[index / SIZE][index % SIZE]));
+    }
+    playerDirtyCells.reset();
 }
 
-void GameBoard::setOpponentBoardClickOrNot(bool interactive) {
-    for (int i = 0; i < SIZE; ++i) {
-        for (int j = 0; j < SIZE; ++j) {
-            QLayoutItem* item = opponentLayoutSecond->itemAtPosition(i, j);
-            if (item && item->widget()) {
-                QPushButton* cell = qobject_cast<QPushButton*>(item->widget());
-                cell->setEnabled(interactive);
-                if (!cell->styleSheet().contains("background-color: black") &&
-                    !cell->styleSheet().contains("background-color: red")) {
-                    cell->setStyleSheet(
-                        QString("background-color: %1; border: 1px solid black;").arg(interactive ? "white" : "gray"));
-                }
-                cell->repaint();
-                cell->update();
+void GameBoard::setupOpponentBoard() {
+    if (opponentCells.empty()) {
+        for (int i = 0; i < SIZE; ++i) {
+            for (int j = 0; j < SIZE; ++j) {
+                QPushButton* cell = new QPushButton();
+                cell->setFixedSize(сellSize, сellSize);
+                connect(cell, &QPushButton::clicked, this, [=]() { emit cellClicked(i, j); });
+                opponentLayoutSecond->addWidget(cell, i, j);
+                opponentCells.push_back(cell);
             }
         }
     }
-    opponentWidgetSecond->repaint();
-    opponentWidgetSecond->update();
+    for (int index = 0; index < SIZE * SIZE; ++index) {
+        QPushButton* cell = opponentCells[index];
+        cell->setEnabled(false);
+        setStyleSheetIfChanged(cell, opponentCellStyle(opponentBoardSecond[index / SIZE][index % SIZE], false));
+    }
+    opponentDirtyCells.reset();
+    opponentShotSinceToggle.reset();
+    opponentInteractive = false;
+    opponentInteractivityDirty = false;
 }
 
-void GameBoard::updatePlayerBoard(int x, int y, const QString& result) {
-    QLayoutItem* item = playerLayoutFirst->itemAtPosition(x, y);
-    if (item && item->widget()) {
-        QPushButton* cell = qobject_cast<QPushButton*>(item->widget());
-        if (result == "miss") {
-            cell->setStyleSheet(missShootStyle);
-        } else if (result == "hit" || result == "kill") {
-            cell->setStyleSheet(winShootStyle);
-        }
-        cell->repaint();
-        cell->update();
+void GameBoard::setOpponentBoardClickOrNot(bool interactive) {
+    opponentInteractive = interactive;
+    opponentInteractivityDirty = true;
+    opponentShotSinceToggle.reset();
+    frameScheduler->requestFrame();
+}
+
+void GameBoard::updatePlayerBoard(int x, int y, QAnyStringView result) {
+    const char shotCell = boardcell::fromShotResult(result);
+    if (shotCell and x >= 0 and x < SIZE and y >= 0 and y < SIZE) {
+        setCell(playerBoardFirst, zobrist::Board::Player, playerHash, x, y, shotCell);
+        gameHistory.append(GameHistory::Board::Player, x, y, shotCell);
+        emit cellChanged(GameHistory::Board::Player, x, y, shotCell);
+        playerDirtyCells.set(x * SIZE + y);
+        frameScheduler->requestFrame();
     }
 }
 
-void GameBoard::updateOpponentBoard(int x, int y, const QString& result) {
-    QLayoutItem* item = opponentLayoutSecond->itemAtPosition(x, y);
-    if (item && item->widget()) {
-        QPushButton* cell = qobject_cast<QPushButton*>(item->widget());
-        if (result == "miss") {
-            cell->setStyleSheet(missShootStyle);
-        } else if (result == "hit" || result == "kill") {
-            cell->setStyleSheet(winShootStyle);
+void GameBoard::updateOpponentBoard(int x, int y, QAnyStringView result) {
+    if (x < 0 or x >= SIZE or y < 0 or y >= SIZE) {
+        return;
+    }
+    const char shotCell = boardcell::fromShotResult(result);
+    if (shotCell) {
+        setCell(opponentBoardSecond, zobrist::Board::Opponent, opponentHash, x, y, shotCell);
+        gameHistory.append(GameHistory::Board::Opponent, x, y, shotCell);
+        emit cellChanged(GameHistory::Board::Opponent, x, y, shotCell);
+    }
+    opponentShotSinceToggle.set(x * SIZE + y);
+    opponentDirtyCells.set(x * SIZE + y);
+    frameScheduler->requestFrame();
+}
+
+void GameBoard::setCell(std::vector<std::vector<char>>& board, zobrist::Board boardId, quint64& hash, int x, int y,
+                        char cell) {
+    const int cellIndex = x * SIZE + y;
+    hash ^= zobrist::cellKey(boardId, cellIndex, board[x][y]) ^ zobrist::cellKey(boardId, cellIndex, cell);
+    board[x][y] = cell;
+}
+
+void GameBoard::flushPendingUpdates() {
+    frameScheduler->flush();
+}
+
+void GameBoard::applyPendingUpdates() {
+    if (playerDirtyCells.any() and static_cast<int>(playerCells.size()) == SIZE * SIZE) {
+        for (int index = 0; index < SIZE * SIZE; ++index) {
+            if (playerDirtyCells.test(index)) {
+                setStyleSheetIfChanged(playerCells[index], playerCellStyle(playerBoardFirst[index / SIZE][index % SIZE]));
+            }
+        }
+    }
+    playerDirtyCells.reset();
+
+    if ((opponentInteractivityDirty or opponentDirtyCells.any()) and
+        static_cast<int>(opponentCells.size()) == SIZE * SIZE) {
+        for (int index = 0; index < SIZE * SIZE; ++index) {
+            if (!opponentInteractivityDirty and !opponentDirtyCells.test(index)) {
+                continue;
+            }
+            QPushButton* cell = opponentCells[index];
+            cell->setEnabled(opponentInteractive and !opponentShotSinceToggle.test(index));
+            setStyleSheetIfChanged(cell,
+                                   opponentCellStyle(opponentBoardSecond[index / SIZE][index % SIZE], opponentInteractive));
         }
-        cell->setEnabled(false);
-        cell->repaint();
-        cell->update();
     }
+    opponentDirtyCells.reset();
+    opponentInteractivityDirty = false;
 }
 
 QWidget* GameBoard::getPlayerWidget() const {
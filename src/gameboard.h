@@ -1,12 +1,18 @@
 #ifndef GAMEBOARD_H
 #define GAMEBOARD_H
 
+#include <QAnyStringView>
 #include <QGridLayout>
 #include <QPushButton>
 #include <QString>
 #include <QWidget>
+#include <bitset>
 #include <vector>
 
+#include "framescheduler.h"
+#include "gamehistory.h"
+#include "zobristhash.h"
+
 class GameBoard : public QObject {
     Q_OBJECT
 
@@ -15,28 +21,59 @@ public:
     ~GameBoard();
 
     void parseAndSaveBoard(const QString& message);
+    void resyncBoards(const QString& message);
+    void restoreBoards(const std::vector<std::vector<char>>& openingBoard,
+                       const std::vector<std::vector<char>>& playerBoard,
+                       const std::vector<std::vector<char>>& opponentBoard);
+    std::vector<std::vector<char>> openingBoard() const;
     QWidget* getPlayerWidget() const;
     QWidget* getOpponentWidget() const;
     void setOpponentBoardClickOrNot(bool interactive);
-    void updatePlayerBoard(int x, int y, const QString& result);
-    void updateOpponentBoard(int x, int y, const QString& result);
+    void updatePlayerBoard(int x, int y, QAnyStringView result);
+    void updateOpponentBoard(int x, int y, QAnyStringView result);
     void cleanFiledForNewGame();
+    void detachWidgets();
+    void flushPendingUpdates();
+    const GameHistory& history() const { return gameHistory; }
+    quint64 boardHash() const { return playerHash ^ opponentHash; }
 
     std::vector<std::vector<char>> playerBoardFirst;
     std::vector<std::vector<char>> opponentBoardSecond;
 
     signals:
         void cellClicked(int x, int y);
+        void frameRendered(qint64 elapsedNs);
+        void cellChanged(GameHistory::Board board, int x, int y, char cell);
 
 private:
     void setupPlayerBoard();
     void setupOpponentBoard();
+    void applyPendingUpdates();
+    void showNewBoards(const std::vector<std::vector<char>>& openingBoard);
+    void readBoards(const QString& message);
+    void recordChanges(GameHistory::Board board, const std::vector<std::vector<char>>& before,
+                       const std::vector<std::vector<char>>& after);
+    void setCell(std::vector<std::vector<char>>& board, zobrist::Board boardId, quint64& hash, int x, int y,
+                 char cell);
 
     static constexpr int SIZE = 10;
+    using CellMask = std::bitset<SIZE * SIZE>;
+
     QWidget* playerWidgetFirst = nullptr;
     QWidget* opponentWidgetSecond = nullptr;
     QGridLayout* playerLayoutFirst = nullptr;
     QGridLayout* opponentLayoutSecond = nullptr;
+    std::vector<QPushButton*> playerCells;
+    std::vector<QPushButton*> opponentCells;
+    FrameScheduler* frameScheduler = nullptr;
+    CellMask playerDirtyCells;
+    CellMask opponentDirtyCells;
+    CellMask opponentShotSinceToggle;
+    bool opponentInteractive = false;
+    bool opponentInteractivityDirty = false;
+    quint64 playerHash = 0;
+    quint64 opponentHash = 0;
+    GameHistory gameHistory;
 };
 
 #endif
\ No newline at end of file
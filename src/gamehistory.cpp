@@ -0,0 +1,78 @@
+#include "gamehistory.h"
+
+#include <algorithm>
+
+#include "boardcell.h"
+
+GameHistory::GameHistory(int snapshotInterval)
+    : interval(std::max(1, snapshotInterval))
+    , arena(arenaBuffer.data(), arenaBuffer.size())
+    , events(&arena)
+    , snapshots(&arena) {
+    clear();
+}
+
+GameHistory::GameHistory(const GameHistory& other)
+    : GameHistory(other.interval) {
+    *this = other;
+}
+
+GameHistory& GameHistory::operator=(const GameHistory& other) {
+    if (this == &other) {
+        return *this;
+    }
+    interval = other.interval;
+    clear();
+    current = other.current;
+    events.assign(other.events.begin(), other.events.end());
+    snapshots.assign(other.snapshots.begin(), other.snapshots.end());
+    return *this;
+}
+
+void GameHistory::start(const std::vector<std::vector<char>>& playerBoard) {
+    clear();
+    for (int i = 0; i < SIZE and i < static_cast<int>(playerBoard.size()); ++i) {
+        for (int j = 0; j < SIZE and j < static_cast<int>(playerBoard[i].size()); ++j) {
+            current.player[i * SIZE + j] = playerBoard[i][j];
+        }
+    }
+    snapshots.front() = current;
+}
+
+void GameHistory::append(Board board, int x, int y, char cell) {
+    if (x < 0 or x >= SIZE or y < 0 or y >= SIZE or !cell) {
+        return;
+    }
+    const Event event{board, static_cast<std::uint8_t>(x * SIZE + y), cell};
+    events.push_back(event);
+    apply(current, event);
+    if (eventCount() % interval == 0) {
+        snapshots.push_back(current);
+    }
+}
+
+void GameHistory::clear() {
+    current.player.fill(boardcell::empty);
+    current.opponent.fill(boardcell::empty);
+    events = std::pmr::vector<Event>(&arena);
+    snapshots = std::pmr::vector<Position>(&arena);
+    arena.release();
+    events.reserve(expectedEventsPerGame);
+    snapshots.reserve(expectedEventsPerGame / interval + 1);
+    snapshots.push_back(current);
+}
+
+GameHistory::Position GameHistory::positionAt(int eventIndex) const {
+    eventIndex = std::clamp(eventIndex, 0, eventCount());
+    const int snapshotIndex = std::min(eventIndex / interval, static_cast<int>(snapshots.size()) - 1);
+    Position position = snapshots[snapshotIndex];
+    for (int i = snapshotIndex * interval; i < eventIndex; ++i) {
+        apply(position, events[i]);
+    }
+    return position;
+}
+
+void GameHistory::apply(Position& position, const Event& event) {
+    Cells& cells = event.board == Board::Player ? position.player : position.opponent;
+    cells[event.cellIndex] = event.cell;
+}
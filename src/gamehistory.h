@@ -0,0 +1,56 @@
+#ifndef GAMEHISTORY_H
+#define GAMEHISTORY_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+class GameHistory {
+public:
+    static constexpr int SIZE = 10;
+    using Cells = std::array<char, SIZE * SIZE>;
+
+    enum class Board : std::uint8_t { Player, Opponent };
+
+    struct Event {
+        Board board;
+        std::uint8_t cellIndex;
+        char cell;
+    };
+
+    struct Position {
+        Cells player;
+        Cells opponent;
+    };
+
+    explicit GameHistory(int snapshotInterval = defaultSnapshotInterval);
+    GameHistory(const GameHistory& other);
+    GameHistory& operator=(const GameHistory& other);
+
+    void start(const std::vector<std::vector<char>>& playerBoard);
+    void append(Board board, int x, int y, char cell);
+    void clear();
+
+    bool isEmpty() const { return events.empty(); }
+    int eventCount() const { return static_cast<int>(events.size()); }
+    const Event& eventAt(int index) const { return events[index]; }
+    Position positionAt(int eventIndex) const;
+
+private:
+    static constexpr int defaultSnapshotInterval = 16;
+    static constexpr int expectedEventsPerGame = SIZE * SIZE * 2;
+    static constexpr std::size_t arenaBytes = 8 * 1024;
+
+    static void apply(Position& position, const Event& event);
+
+    int interval;
+    Position current;
+    alignas(std::max_align_t) std::array<std::byte, arenaBytes> arenaBuffer;
+    std::pmr::monotonic_buffer_resource arena;
+    std::pmr::vector<Event> events;
+    std::pmr::vector<Position> snapshots;
+};
+
+#endif
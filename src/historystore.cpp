@@ -0,0 +1,253 @@
+#include "historystore.h"
+
+#include <QDir>
+#include <QStandardPaths>
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+namespace {
+constexpr std::uint32_t historyMagic = 0x53484253;
+constexpr std::uint32_t historyVersion = 1;
+constexpr int gamesPerBlock = 1024;
+constexpr int opponentShotBytes = 16;
+constexpr std::uint8_t noFirstShot = 0xff;
+constexpr auto historyFileName = "games.dat";
+
+struct FileHeader {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t gamesPerBlock;
+    std::uint32_t reserved;
+    std::uint64_t gameCount;
+    std::uint8_t padding[40];
+};
+
+// Block summaries double as the query index: aggregates over the whole file only touch
+// one summary per block, while the per-game columns stay cold.
+struct BlockSummary {
+    std::uint32_t games;
+    std::uint32_t wins;
+    std::uint64_t shotsInWins;
+    std::uint32_t firstShotHeatmap[HistoryStore::CELLS];
+    std::uint32_t opponentShotHeatmap[HistoryStore::CELLS];
+};
+
+struct Block {
+    BlockSummary summary;
+    std::uint8_t won[gamesPerBlock];
+    std::uint8_t firstShotCell[gamesPerBlock];
+    std::uint16_t shotsFired[gamesPerBlock];
+    std::uint16_t shotsHit[gamesPerBlock];
+    std::int64_t finishedAtMs[gamesPerBlock];
+    std::uint8_t opponentShots[gamesPerBlock][opponentShotBytes];
+};
+
+static_assert(sizeof(FileHeader) == 64);
+static_assert(sizeof(Block) % alignof(Block) == 0);
+static_assert(std::is_trivially_copyable_v<FileHeader> and std::is_trivially_copyable_v<Block>);
+
+qint64 blockOffset(std::uint64_t blockIndex) {
+    return static_cast<qint64>(sizeof(FileHeader) + blockIndex * sizeof(Block));
+}
+
+std::uint64_t blockCount(std::uint64_t games) {
+    return (games + gamesPerBlock - 1) / gamesPerBlock;
+}
+
+bool isValidHeader(const FileHeader& header) {
+    return header.magic == historyMagic and header.version == historyVersion and
+           header.gamesPerBlock == gamesPerBlock;
+}
+
+std::uint16_t clampToColumn(int value) {
+    return static_cast<std::uint16_t>(std::clamp(value, 0, 0xffff));
+}
+
+void addToSummary(BlockSummary& summary, const Block& block, int slot) {
+    summary.games++;
+    if (block.won[slot]) {
+        summary.wins++;
+        summary.shotsInWins += block.shotsFired[slot];
+    }
+    if (block.firstShotCell[slot] < HistoryStore::CELLS) {
+        summary.firstShotHeatmap[block.firstShotCell[slot]]++;
+    }
+    for (int cell = 0; cell < HistoryStore::CELLS; ++cell) {
+        if ((block.opponentShots[slot][cell / 8] >> (cell % 8)) & 1u) {
+            summary.opponentShotHeatmap[cell]++;
+        }
+    }
+}
+
+// The summary is written before the header's game count, so after a crash in between it can
+// be one game ahead of the count. The columns are the source of truth for such a block.
+BlockSummary summaryFromColumns(const Block& block, int games) {
+    BlockSummary summary{};
+    for (int slot = 0; slot < games; ++slot) {
+        addToSummary(summary, block, slot);
+    }
+    return summary;
+}
+}
+
+HistoryStore::HistoryStore(const QString& filePath)
+    : file(filePath) {
+}
+
+HistoryStore::~HistoryStore() {
+    unmap();
+}
+
+QString HistoryStore::defaultFilePath() {
+    const QString directory = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    QDir().mkpath(directory);
+    return QDir(directory).filePath(historyFileName);
+}
+
+bool HistoryStore::append(const GameSummary& game) {
+    unmap();
+    if (!file.open(QIODevice::ReadWrite)) {
+        return false;
+    }
+
+    FileHeader header{};
+    if (file.size() < static_cast<qint64>(sizeof(FileHeader))) {
+        header.magic = historyMagic;
+        header.version = historyVersion;
+        header.gamesPerBlock = gamesPerBlock;
+    } else if (file.read(reinterpret_cast<char*>(&header), sizeof(header)) != static_cast<qint64>(sizeof(header)) or
+               !isValidHeader(header)) {
+        file.close();
+        return false;
+    }
+
+    const std::uint64_t blockIndex = header.gameCount / gamesPerBlock;
+    const int slot = static_cast<int>(header.gameCount % gamesPerBlock);
+    const qint64 offset = blockOffset(blockIndex);
+    if (file.size() < offset + static_cast<qint64>(sizeof(Block)) and !file.resize(offset + sizeof(Block))) {
+        file.close();
+        return false;
+    }
+    uchar* data = file.map(offset, sizeof(Block));
+    if (!data) {
+        file.close();
+        return false;
+    }
+
+    auto* block = reinterpret_cast<Block*>(data);
+    const bool hasFirstShot = game.firstShotCell >= 0 and game.firstShotCell < CELLS;
+    block->won[slot] = game.won ? 1 : 0;
+    block->firstShotCell[slot] = hasFirstShot ? static_cast<std::uint8_t>(game.firstShotCell) : noFirstShot;
+    block->shotsFired[slot] = clampToColumn(game.shotsFired);
+    block->shotsHit[slot] = clampToColumn(game.shotsHit);
+    block->finishedAtMs[slot] = game.finishedAtMs;
+    std::memset(block->opponentShots[slot], 0, opponentShotBytes);
+    for (int cell = 0; cell < CELLS; ++cell) {
+        if (game.opponentShots.test(cell)) {
+            block->opponentShots[slot][cell / 8] |= static_cast<std::uint8_t>(1u << (cell % 8));
+        }
+    }
+
+    BlockSummary& summary = block->summary;
+    if (summary.games != static_cast<std::uint32_t>(slot)) {
+        summary = summaryFromColumns(*block, slot);
+    }
+    addToSummary(summary, *block, slot);
+    file.unmap(data);
+
+    header.gameCount++;
+    const bool written = file.seek(0) and
+                         file.write(reinterpret_cast<const char*>(&header), sizeof(header)) ==
+                             static_cast<qint64>(sizeof(header));
+    file.close();
+    return written;
+}
+
+HistoryStore::Statistics HistoryStore::statistics() {
+    Statistics statistics;
+    if (!mapForReading()) {
+        return statistics;
+    }
+    const auto* header = reinterpret_cast<const FileHeader*>(mappedData);
+    const std::uint64_t blocks = blockCount(header->gameCount);
+    for (std::uint64_t blockIndex = 0; blockIndex < blocks; ++blockIndex) {
+        const auto* block = reinterpret_cast<const Block*>(mappedData + blockOffset(blockIndex));
+        const int gamesInBlock =
+            static_cast<int>(std::min<std::uint64_t>(gamesPerBlock, header->gameCount - blockIndex * gamesPerBlock));
+        const BlockSummary* summary = &block->summary;
+        BlockSummary rebuilt;
+        if (summary->games != static_cast<std::uint32_t>(gamesInBlock)) {
+            rebuilt = summaryFromColumns(*block, gamesInBlock);
+            summary = &rebuilt;
+        }
+        statistics.games += summary->games;
+        statistics.wins += summary->wins;
+        statistics.shotsInWins += summary->shotsInWins;
+        for (int cell = 0; cell < CELLS; ++cell) {
+            statistics.firstShotHeatmap[cell] += summary->firstShotHeatmap[cell];
+            statistics.opponentShotHeatmap[cell] += summary->opponentShotHeatmap[cell];
+        }
+    }
+    return statistics;
+}
+
+std::uint64_t HistoryStore::gameCount() {
+    if (!mapForReading()) {
+        return 0;
+    }
+    return reinterpret_cast<const FileHeader*>(mappedData)->gameCount;
+}
+
+HistoryStore::GameSummary HistoryStore::gameAt(std::uint64_t index) {
+    GameSummary game;
+    if (index >= gameCount()) {
+        return game;
+    }
+    const auto* block = reinterpret_cast<const Block*>(mappedData + blockOffset(index / gamesPerBlock));
+    const int slot = static_cast<int>(index % gamesPerBlock);
+    game.won = block->won[slot] != 0;
+    game.shotsFired = block->shotsFired[slot];
+    game.shotsHit = block->shotsHit[slot];
+    game.firstShotCell = block->firstShotCell[slot] == noFirstShot ? -1 : block->firstShotCell[slot];
+    game.finishedAtMs = block->finishedAtMs[slot];
+    for (int cell = 0; cell < CELLS; ++cell) {
+        game.opponentShots[cell] = (block->opponentShots[slot][cell / 8] >> (cell % 8)) & 1u;
+    }
+    return game;
+}
+
+bool HistoryStore::mapForReading() {
+    if (mappedData) {
+        return true;
+    }
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    const qint64 size = file.size();
+    uchar* data = size >= static_cast<qint64>(sizeof(FileHeader)) ? file.map(0, size) : nullptr;
+    if (!data) {
+        file.close();
+        return false;
+    }
+    const auto* header = reinterpret_cast<const FileHeader*>(data);
+    if (!isValidHeader(*header) or blockOffset(blockCount(header->gameCount)) > size) {
+        file.unmap(data);
+        file.close();
+        return false;
+    }
+    mappedData = data;
+    mappedSize = size;
+    return true;
+}
+
+void HistoryStore::unmap() {
+    if (mappedData) {
+        file.unmap(mappedData);
+        mappedData = nullptr;
+        mappedSize = 0;
+    }
+    if (file.isOpen()) {
+        file.close();
+    }
+}
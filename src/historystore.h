@@ -0,0 +1,54 @@
+#ifndef HISTORYSTORE_H
+#define HISTORYSTORE_H
+
+#include <QFile>
+#include <QString>
+#include <array>
+#include <bitset>
+#include <cstdint>
+
+class HistoryStore {
+public:
+    static constexpr int CELLS = 100;
+    using Heatmap = std::array<std::uint32_t, CELLS>;
+
+    struct GameSummary {
+        bool won = false;
+        int shotsFired = 0;
+        int shotsHit = 0;
+        int firstShotCell = -1;
+        std::bitset<CELLS> opponentShots;
+        std::int64_t finishedAtMs = 0;
+    };
+
+    struct Statistics {
+        std::uint64_t games = 0;
+        std::uint64_t wins = 0;
+        std::uint64_t shotsInWins = 0;
+        Heatmap firstShotHeatmap{};
+        Heatmap opponentShotHeatmap{};
+
+        double winRate() const { return games ? double(wins) / double(games) : 0.0; }
+        double averageShotsToWin() const { return wins ? double(shotsInWins) / double(wins) : 0.0; }
+    };
+
+    explicit HistoryStore(const QString& filePath);
+    ~HistoryStore();
+
+    static QString defaultFilePath();
+
+    bool append(const GameSummary& game);
+    Statistics statistics();
+    std::uint64_t gameCount();
+    GameSummary gameAt(std::uint64_t index);
+
+private:
+    bool mapForReading();
+    void unmap();
+
+    QFile file;
+    uchar* mappedData = nullptr;
+    qint64 mappedSize = 0;
+};
+
+#endif
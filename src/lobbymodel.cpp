@@ -0,0 +1,334 @@
+#include "lobbymodel.h"
+
+#include <QtConcurrent/QtConcurrentRun>
+#include <algorithm>
+
+namespace {
+constexpr QStringView lobbyPrefix = u"Lobby ";
+constexpr QStringView lobbyAddPrefix = u"Lobby add: ";
+constexpr QStringView lobbyUpdatePrefix = u"Lobby update: ";
+constexpr QStringView lobbyRemovePrefix = u"Lobby remove: ";
+constexpr int bulkDeltaThreshold = 256;
+constexpr int playersPerSession = 2;
+
+bool splitSessionAndPlayers(QStringView rest, QString& id, int& players) {
+    const qsizetype space = rest.lastIndexOf(u' ');
+    if (space <= 0) {
+        return false;
+    }
+    bool ok = false;
+    players = rest.mid(space + 1).toInt(&ok);
+    id = rest.left(space).toString();
+    return ok;
+}
+}
+
+LobbyModel::LobbyModel(QObject* parent)
+    : QAbstractListModel(parent) {
+    connect(&refreshWatcher, &QFutureWatcher<std::vector<QString>>::finished, this, &LobbyModel::onRefreshFinished);
+}
+
+LobbyModel::~LobbyModel() {
+    refreshWatcher.waitForFinished();
+}
+
+int LobbyModel::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : static_cast<int>(visibleRows.size());
+}
+
+QVariant LobbyModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() or index.row() >= static_cast<int>(visibleRows.size())) {
+        return {};
+    }
+    const LobbySession& session = sessions[visibleRows[index.row()]];
+    switch (role) {
+        case Qt::DisplayRole:
+            return tr("%1 (%2/%3)").arg(session.id).arg(session.players).arg(playersPerSession);
+        case SessionIdRole:
+            return session.id;
+        case PlayersRole:
+            return session.players;
+        default:
+            return {};
+    }
+}
+
+QHash<int, QByteArray> LobbyModel::roleNames() const {
+    QHash<int, QByteArray> roles = QAbstractListModel::roleNames();
+    roles.insert(SessionIdRole, "sessionId");
+    roles.insert(PlayersRole, "players");
+    return roles;
+}
+
+bool LobbyModel::applyMessage(const QString& message) {
+    if (!message.startsWith(lobbyPrefix)) {
+        return false;
+    }
+    const bool bulk = message.count(u'\n') >= bulkDeltaThreshold;
+    if (bulk) {
+        beginResetModel();
+        bulkUpdate = true;
+    }
+    for (QStringView line : QStringView(message).split(u'\n', Qt::SkipEmptyParts)) {
+        applyLine(line.trimmed());
+    }
+    if (bulk) {
+        bulkUpdate = false;
+        endResetModel();
+        startRefresh();
+    }
+    return true;
+}
+
+bool LobbyModel::applyLine(QStringView line) {
+    QString id;
+    int players = 0;
+    if (line.startsWith(lobbyAddPrefix)) {
+        if (!splitSessionAndPlayers(line.mid(lobbyAddPrefix.size()), id, players)) {
+            return false;
+        }
+        addSession(id, players);
+    } else if (line.startsWith(lobbyUpdatePrefix)) {
+        if (!splitSessionAndPlayers(line.mid(lobbyUpdatePrefix.size()), id, players)) {
+            return false;
+        }
+        updateSession(id, players);
+    } else if (line.startsWith(lobbyRemovePrefix)) {
+        removeSession(line.mid(lobbyRemovePrefix.size()).trimmed().toString());
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void LobbyModel::addSession(const QString& id, int players) {
+    if (indexById.contains(id)) {
+        updateSession(id, players);
+        return;
+    }
+    if (refreshRunning) {
+        updatedDuringRefresh.insert(id);
+    }
+    const int storageIndex = static_cast<int>(sessions.size());
+    sessions.push_back({id, players, nextSequence++});
+    indexById.insert(id, storageIndex);
+    if (!bulkUpdate) {
+        insertVisible(storageIndex);
+    }
+}
+
+void LobbyModel::updateSession(const QString& id, int players) {
+    const int storageIndex = indexById.value(id, -1);
+    if (storageIndex < 0 or sessions[storageIndex].players == players) {
+        return;
+    }
+    if (refreshRunning) {
+        updatedDuringRefresh.insert(id);
+    }
+    if (appliedQuery.sortKey == SortKey::Players) {
+        removeVisible(storageIndex);
+        sessions[storageIndex].players = players;
+        insertVisible(storageIndex);
+        return;
+    }
+    sessions[storageIndex].players = players;
+    const int row = bulkUpdate ? -1 : visiblePosition(storageIndex);
+    if (row >= 0) {
+        emit dataChanged(index(row), index(row));
+    }
+}
+
+void LobbyModel::removeSession(const QString& id) {
+    const auto it = indexById.constFind(id);
+    if (it == indexById.cend()) {
+        return;
+    }
+    if (refreshRunning) {
+        updatedDuringRefresh.insert(id);
+    }
+    const int storageIndex = it.value();
+    indexById.erase(it);
+    removeVisible(storageIndex);
+
+    const int lastIndex = static_cast<int>(sessions.size()) - 1;
+    if (storageIndex != lastIndex) {
+        const int lastRow = visiblePosition(lastIndex);
+        sessions[storageIndex] = std::move(sessions[lastIndex]);
+        indexById[sessions[storageIndex].id] = storageIndex;
+        if (lastRow >= 0) {
+            visibleRows[lastRow] = storageIndex;
+        }
+    }
+    sessions.pop_back();
+}
+
+void LobbyModel::clear() {
+    beginResetModel();
+    sessions.clear();
+    indexById.clear();
+    visibleRows.clear();
+    updatedDuringRefresh.clear();
+    requestedQuery = Query();
+    appliedQuery = Query();
+    runningQuery = Query();
+    refreshQueued = false;
+    discardRefreshResult = refreshRunning;
+    endResetModel();
+}
+
+void LobbyModel::setFilterText(const QString& text) {
+    requestedQuery.filterText = text.trimmed();
+    startRefresh();
+}
+
+void LobbyModel::setSortKey(SortKey key) {
+    requestedQuery.sortKey = key;
+    startRefresh();
+}
+
+QString LobbyModel::sessionIdAt(int row) const {
+    if (row < 0 or row >= static_cast<int>(visibleRows.size())) {
+        return {};
+    }
+    return sessions[visibleRows[row]].id;
+}
+
+bool LobbyModel::matches(const LobbySession& session, const Query& query) {
+    return query.filterText.isEmpty() or session.id.contains(query.filterText, Qt::CaseInsensitive);
+}
+
+bool LobbyModel::lessThan(const LobbySession& first, const LobbySession& second, SortKey key) {
+    switch (key) {
+        case SortKey::SessionId: {
+            const int order = first.id.compare(second.id, Qt::CaseInsensitive);
+            if (order != 0) {
+                return order < 0;
+            }
+            break;
+        }
+        case SortKey::Players:
+            if (first.players != second.players) {
+                return first.players < second.players;
+            }
+            break;
+        case SortKey::Newest:
+            break;
+    }
+    return first.sequence > second.sequence;
+}
+
+std::vector<QString> LobbyModel::computeRows(std::vector<LobbySession> snapshot, Query query) {
+    const auto end = std::remove_if(snapshot.begin(), snapshot.end(),
+                                    [&query](const LobbySession& session) { return !matches(session, query); });
+    snapshot.erase(end, snapshot.end());
+    std::sort(snapshot.begin(), snapshot.end(), [&query](const LobbySession& first, const LobbySession& second) {
+        return lessThan(first, second, query.sortKey);
+    });
+
+    std::vector<QString> ids;
+    ids.reserve(snapshot.size());
+    for (LobbySession& session : snapshot) {
+        ids.push_back(std::move(session.id));
+    }
+    return ids;
+}
+
+int LobbyModel::visiblePosition(int storageIndex) const {
+    const int row = insertionRow(storageIndex);
+    if (row >= static_cast<int>(visibleRows.size()) or visibleRows[row] != storageIndex) {
+        return -1;
+    }
+    return row;
+}
+
+int LobbyModel::insertionRow(int storageIndex) const {
+    const auto it = std::lower_bound(visibleRows.begin(), visibleRows.end(), storageIndex, [this](int first, int second) {
+        return lessThan(sessions[first], sessions[second], appliedQuery.sortKey);
+    });
+    return static_cast<int>(it - visibleRows.begin());
+}
+
+void LobbyModel::insertVisible(int storageIndex) {
+    if (!matches(sessions[storageIndex], appliedQuery)) {
+        return;
+    }
+    const int row = insertionRow(storageIndex);
+    if (!bulkUpdate) {
+        beginInsertRows(QModelIndex(), row, row);
+    }
+    visibleRows.insert(visibleRows.begin() + row, storageIndex);
+    if (!bulkUpdate) {
+        endInsertRows();
+    }
+}
+
+void LobbyModel::removeVisible(int storageIndex) {
+    const int row = visiblePosition(storageIndex);
+    if (row < 0) {
+        return;
+    }
+    if (!bulkUpdate) {
+        beginRemoveRows(QModelIndex(), row, row);
+    }
+    visibleRows.erase(visibleRows.begin() + row);
+    if (!bulkUpdate) {
+        endRemoveRows();
+    }
+}
+
+void LobbyModel::startRefresh() {
+    if (refreshRunning) {
+        refreshQueued = true;
+        return;
+    }
+    refreshRunning = true;
+    runningQuery = requestedQuery;
+    snapshotSequence = nextSequence;
+    updatedDuringRefresh.clear();
+    refreshWatcher.setFuture(QtConcurrent::run(&LobbyModel::computeRows, sessions, runningQuery));
+}
+
+void LobbyModel::onRefreshFinished() {
+    refreshRunning = false;
+    if (discardRefreshResult) {
+        discardRefreshResult = false;
+        if (refreshQueued) {
+            refreshQueued = false;
+            startRefresh();
+        }
+        return;
+    }
+    if (refreshQueued and !(requestedQuery == runningQuery)) {
+        refreshQueued = false;
+        startRefresh();
+        return;
+    }
+
+    const std::vector<QString> ids = refreshWatcher.result();
+    beginResetModel();
+    appliedQuery = runningQuery;
+    visibleRows.clear();
+    visibleRows.reserve(ids.size());
+    for (const QString& id : ids) {
+        const int storageIndex = indexById.value(id, -1);
+        if (storageIndex >= 0 and !updatedDuringRefresh.contains(id)) {
+            visibleRows.push_back(storageIndex);
+        }
+    }
+    for (int storageIndex = 0; storageIndex < static_cast<int>(sessions.size()); ++storageIndex) {
+        const LobbySession& session = sessions[storageIndex];
+        const bool changedSinceSnapshot =
+            session.sequence >= snapshotSequence or updatedDuringRefresh.contains(session.id);
+        if (changedSinceSnapshot and matches(session, appliedQuery)) {
+            visibleRows.insert(visibleRows.begin() + insertionRow(storageIndex), storageIndex);
+        }
+    }
+    updatedDuringRefresh.clear();
+    endResetModel();
+    emit refreshFinished();
+
+    if (refreshQueued) {
+        refreshQueued = false;
+        startRefresh();
+    }
+}
@@ -0,0 +1,84 @@
+#ifndef LOBBYMODEL_H
+#define LOBBYMODEL_H
+
+#include <QAbstractListModel>
+#include <QFutureWatcher>
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <vector>
+
+struct LobbySession {
+    QString id;
+    int players = 0;
+    quint64 sequence = 0;
+};
+
+class LobbyModel : public QAbstractListModel {
+    Q_OBJECT
+
+public:
+    enum Roles { SessionIdRole = Qt::UserRole + 1, PlayersRole };
+    enum class SortKey { Newest, SessionId, Players };
+
+    explicit LobbyModel(QObject* parent = nullptr);
+    ~LobbyModel() override;
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    bool applyMessage(const QString& message);
+    void addSession(const QString& id, int players);
+    void updateSession(const QString& id, int players);
+    void removeSession(const QString& id);
+    void clear();
+
+    void setFilterText(const QString& text);
+    void setSortKey(SortKey key);
+    bool isRefreshing() const { return refreshRunning or refreshQueued; }
+    int sessionCount() const { return static_cast<int>(sessions.size()); }
+    QString sessionIdAt(int row) const;
+
+    signals:
+        void refreshFinished();
+
+private:
+    struct Query {
+        QString filterText;
+        SortKey sortKey = SortKey::Newest;
+
+        bool operator==(const Query& other) const {
+            return filterText == other.filterText and sortKey == other.sortKey;
+        }
+    };
+
+    static bool matches(const LobbySession& session, const Query& query);
+    static bool lessThan(const LobbySession& first, const LobbySession& second, SortKey key);
+    static std::vector<QString> computeRows(std::vector<LobbySession> snapshot, Query query);
+
+    bool applyLine(QStringView line);
+    int visiblePosition(int storageIndex) const;
+    int insertionRow(int storageIndex) const;
+    void insertVisible(int storageIndex);
+    void removeVisible(int storageIndex);
+    void startRefresh();
+    void onRefreshFinished();
+
+    std::vector<LobbySession> sessions;
+    QHash<QString, int> indexById;
+    std::vector<int> visibleRows;
+    Query appliedQuery;
+    Query requestedQuery;
+    Query runningQuery;
+    quint64 nextSequence = 0;
+    quint64 snapshotSequence = 0;
+    QSet<QString> updatedDuringRefresh;
+    QFutureWatcher<std::vector<QString>> refreshWatcher;
+    bool refreshRunning = false;
+    bool refreshQueued = false;
+    bool discardRefreshResult = false;
+    bool bulkUpdate = false;
+};
+
+#endif
@@ -0,0 +1,65 @@
+#include "lobbywidget.h"
+
+#include <QHBoxLayout>
+#include <QVBoxLayout>
+
+namespace {
+constexpr auto filterPlaceholder = "Поиск по ID сессии";
+constexpr auto sortNewestText = "Сначала новые";
+constexpr auto sortSessionIdText = "По ID сессии";
+constexpr auto sortPlayersText = "По числу игроков";
+constexpr auto joinSelectedText = "Присоединиться";
+constexpr auto backText = "Назад";
+}
+
+LobbyWidget::LobbyWidget(LobbyModel* model, QWidget* parent)
+    : QWidget(parent)
+    , lobbyModel(model)
+    , filterInput(new QLineEdit(this))
+    , sortSelector(new QComboBox(this))
+    , sessionList(new QListView(this))
+    , joinButton(new QPushButton(tr(joinSelectedText), this))
+    , backButton(new QPushButton(tr(backText), this)) {
+    filterInput->setPlaceholderText(tr(filterPlaceholder));
+    sortSelector->addItem(tr(sortNewestText), static_cast<int>(LobbyModel::SortKey::Newest));
+    sortSelector->addItem(tr(sortSessionIdText), static_cast<int>(LobbyModel::SortKey::SessionId));
+    sortSelector->addItem(tr(sortPlayersText), static_cast<int>(LobbyModel::SortKey::Players));
+
+    sessionList->setModel(lobbyModel);
+    sessionList->setUniformItemSizes(true);
+    sessionList->setSelectionMode(QAbstractItemView::SingleSelection);
+    sessionList->setEditTriggers(QAbstractItemView::NoEditTriggers);
+
+    auto* controlsLayout = new QHBoxLayout;
+    controlsLayout->addWidget(filterInput);
+    controlsLayout->addWidget(sortSelector);
+
+    auto* buttonsLayout = new QHBoxLayout;
+    buttonsLayout->addWidget(backButton);
+    buttonsLayout->addStretch();
+    buttonsLayout->addWidget(joinButton);
+
+    auto* layout = new QVBoxLayout(this);
+    layout->addLayout(controlsLayout);
+    layout->addWidget(sessionList);
+    layout->addLayout(buttonsLayout);
+
+    connect(filterInput, &QLineEdit::textChanged, lobbyModel, &LobbyModel::setFilterText);
+    connect(sortSelector, &QComboBox::currentIndexChanged, this, &LobbyWidget::onSortChanged);
+    connect(sessionList, &QListView::doubleClicked, this, &LobbyWidget::onJoinClicked);
+    connect(joinButton, &QPushButton::clicked, this, &LobbyWidget::onJoinClicked);
+    connect(backButton, &QPushButton::clicked, this, &LobbyWidget::backRequested);
+}
+
+LobbyWidget::~LobbyWidget() = default;
+
+void LobbyWidget::onJoinClicked() {
+    const QString sessionId = lobbyModel->sessionIdAt(sessionList->currentIndex().row());
+    if (!sessionId.isEmpty()) {
+        emit sessionChosen(sessionId);
+    }
+}
+
+void LobbyWidget::onSortChanged(int index) {
+    lobbyModel->setSortKey(static_cast<LobbyModel::SortKey>(sortSelector->itemData(index).toInt()));
+}
@@ -0,0 +1,35 @@
+#ifndef LOBBYWIDGET_H
+#define LOBBYWIDGET_H
+
+#include <QComboBox>
+#include <QLineEdit>
+#include <QListView>
+#include <QPushButton>
+#include <QWidget>
+
+#include "lobbymodel.h"
+
+class LobbyWidget : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit LobbyWidget(LobbyModel* model, QWidget* parent = nullptr);
+    ~LobbyWidget() override;
+
+    signals:
+        void sessionChosen(const QString& sessionId);
+    void backRequested();
+
+private:
+    void onJoinClicked();
+    void onSortChanged(int index);
+
+    LobbyModel* lobbyModel = nullptr;
+    QLineEdit* filterInput = nullptr;
+    QComboBox* sortSelector = nullptr;
+    QListView* sessionList = nullptr;
+    QPushButton* joinButton = nullptr;
+    QPushButton* backButton = nullptr;
+};
+
+#endif
@@ -0,0 +1,94 @@
+#include "localsockettransport.h"
+
+#include <QtEndian>
+#include <algorithm>
+
+namespace {
+constexpr int frameHeaderBytes = sizeof(quint32);
+constexpr quint32 maxFrameBytes = 16 * 1024 * 1024;
+}
+
+LocalSocketTransport::LocalSocketTransport(QObject* parent)
+    : LocalSocketTransport(new QLocalSocket, parent) {
+}
+
+LocalSocketTransport::LocalSocketTransport(QLocalSocket* socket, QObject* parent)
+    : Transport(parent)
+    , localSocket(socket) {
+    localSocket->setParent(this);
+    connect(localSocket, &QLocalSocket::connected, this, &Transport::connected);
+    connect(localSocket, &QLocalSocket::disconnected, this, &Transport::disconnected);
+    connect(localSocket, &QLocalSocket::readyRead, this, &LocalSocketTransport::onReadyRead);
+    connect(localSocket, &QLocalSocket::connected, this, [this] { isOpening = false; });
+    connect(localSocket, &QLocalSocket::errorOccurred, this, &LocalSocketTransport::onErrorOccurred);
+}
+
+LocalSocketTransport::~LocalSocketTransport() = default;
+
+QString LocalSocketTransport::serverNameFromUrl(const QUrl& url) {
+    return url.host().isEmpty() ? url.path() : url.host();
+}
+
+QByteArray LocalSocketTransport::encodeFrame(const QString& message) {
+    const QByteArray payload = message.toUtf8();
+    QByteArray frame(frameHeaderBytes + payload.size(), Qt::Uninitialized);
+    qToBigEndian<quint32>(static_cast<quint32>(payload.size()), frame.data());
+    std::copy(payload.cbegin(), payload.cend(), frame.begin() + frameHeaderBytes);
+    return frame;
+}
+
+void LocalSocketTransport::open(const QUrl& url) {
+    readBuffer.clear();
+    isOpening = true;
+    localSocket->connectToServer(serverNameFromUrl(url));
+}
+
+void LocalSocketTransport::close() {
+    isOpening = false;
+    if (localSocket->state() != QLocalSocket::UnconnectedState) {
+        localSocket->disconnectFromServer();
+    }
+}
+
+bool LocalSocketTransport::isConnected() const {
+    return localSocket->state() == QLocalSocket::ConnectedState;
+}
+
+qint64 LocalSocketTransport::sendTextMessage(const QString& message) {
+    if (!isConnected()) {
+        return 0;
+    }
+    const QByteArray frame = encodeFrame(message);
+    const qint64 written = localSocket->write(frame);
+    return written < 0 ? written : written - frameHeaderBytes;
+}
+
+void LocalSocketTransport::onErrorOccurred() {
+    // A socket that never connected does not emit disconnected() by itself.
+    if (!isOpening or localSocket->state() == QLocalSocket::ConnectedState) {
+        return;
+    }
+    isOpening = false;
+    QMetaObject::invokeMethod(
+        this, [this] { emit disconnected(); }, Qt::QueuedConnection);
+}
+
+void LocalSocketTransport::onReadyRead() {
+    readBuffer.append(localSocket->readAll());
+
+    qsizetype offset = 0;
+    while (readBuffer.size() - offset >= frameHeaderBytes) {
+        const quint32 length = qFromBigEndian<quint32>(readBuffer.constData() + offset);
+        if (length > maxFrameBytes) {
+            readBuffer.clear();
+            localSocket->abort();
+            return;
+        }
+        if (readBuffer.size() - offset - frameHeaderBytes < static_cast<qsizetype>(length)) {
+            break;
+        }
+        emit textMessageReceived(QString::fromUtf8(readBuffer.constData() + offset + frameHeaderBytes, length));
+        offset += frameHeaderBytes + length;
+    }
+    readBuffer.remove(0, offset);
+}
@@ -0,0 +1,34 @@
+#ifndef LOCALSOCKETTRANSPORT_H
+#define LOCALSOCKETTRANSPORT_H
+
+#include <QByteArray>
+#include <QLocalSocket>
+
+#include "transport.h"
+
+class LocalSocketTransport : public Transport {
+    Q_OBJECT
+
+public:
+    explicit LocalSocketTransport(QObject* parent = nullptr);
+    explicit LocalSocketTransport(QLocalSocket* socket, QObject* parent = nullptr);
+    ~LocalSocketTransport() override;
+
+    static QString serverNameFromUrl(const QUrl& url);
+    static QByteArray encodeFrame(const QString& message);
+
+    void open(const QUrl& url) override;
+    void close() override;
+    bool isConnected() const override;
+    qint64 sendTextMessage(const QString& message) override;
+
+private:
+    void onErrorOccurred();
+    void onReadyRead();
+
+    QLocalSocket* localSocket = nullptr;
+    QByteArray readBuffer;
+    bool isOpening = false;
+};
+
+#endif
@@ -1,17 +1,40 @@
 #include "mainwindow.h"
 
-#include <QAbstractSocket>
+#include <QDateTime>
+#include <QDebug>
 #include <QHBoxLayout>
 #include <QMessageBox>
-#include <QRegularExpression>
+#include <QShortcut>
 #include <QTimer>
+#include <algorithm>
+#include <optional>
+
+#include "boardcell.h"
+#include "statswidget.h"
+#include "timelinescrubber.h"
 
 namespace {
 constexpr QSize defaultWindowSize{600, 400};
 constexpr auto webSocketUrl = "ws://localhost:8080";
+constexpr auto serverUrlVariable = "SEA_BATTLE_SERVER_URL";
+constexpr auto perfHudVariable = "SEA_BATTLE_PERF_HUD";
+constexpr auto perfHudShortcut = Qt::Key_F3;
 constexpr auto sessionInputPlaceholder = "Введите ID сессии";
 constexpr auto createSessionText = "Создать сессию";
 constexpr auto joinSessionText = "Присоединиться к сессии";
+constexpr auto reviewGameText = "Просмотр последней партии";
+constexpr auto statisticsText = "Статистика";
+constexpr auto lobbyText = "Список сессий";
+constexpr auto lobbySubscribeCommand = "lobby:subscribe";
+constexpr auto lobbyUnsubscribeCommand = "lobby:unsubscribe";
+constexpr auto resyncCommand = "resync:%1";
+constexpr auto resumeCommand = "resume:%1:%2";
+constexpr QStringView frameHashMarker = u" #";
+constexpr QStringView sessionCreatedPrefix = u"Session created:";
+constexpr QStringView connectedPrefix = u"Connected to session:";
+constexpr QStringView shotResultPrefix = u"Shot result:";
+constexpr QStringView opponentShotPrefix = u"Opponent shot at ";
+constexpr int frameHashDigits = 16;
 constexpr auto askingToConnectText = "Введите ID сессии для создания или присоединения";
 constexpr auto gameStartedText = "Игра началась!";
 constexpr auto playerBoardLabel = "Ваше поле";
@@ -24,35 +47,120 @@ constexpr auto gameOverTitle = "Игра окончена";
 constexpr auto victory = "Победа!";
 constexpr auto defeat = "Поражение!";
 constexpr int gameOverDialogDelayMs = 100;
+constexpr int boardSide = 10;
+constexpr int resyncRetryMs = 2000;
+constexpr int maxResyncAttempts = 3;
+
+QUrl serverUrl() {
+    return Transport::urlFromString(qEnvironmentVariable(serverUrlVariable, webSocketUrl));
+}
+
+std::optional<quint64> takeFrameHash(QStringView& message) {
+    const qsizetype markerSize = frameHashMarker.size();
+    if (message.size() < markerSize + frameHashDigits) {
+        return std::nullopt;
+    }
+    const qsizetype markerAt = message.size() - frameHashDigits - markerSize;
+    if (message.mid(markerAt, markerSize) != frameHashMarker) {
+        return std::nullopt;
+    }
+    bool ok = false;
+    const quint64 hash = message.right(frameHashDigits).toULongLong(&ok, 16);
+    if (!ok) {
+        return std::nullopt;
+    }
+    message.truncate(markerAt);
+    return hash;
+}
+
+QStringView leadingWord(QStringView text) {
+    qsizetype length = 0;
+    while (length < text.size() and (text[length].isLetterOrNumber() or text[length] == u'_')) {
+        ++length;
+    }
+    return text.left(length);
+}
+
+AllocationLedger::MessageType messageTypeOf(QStringView message) {
+    using MessageType = AllocationLedger::MessageType;
+    if (message.startsWith(u"Lobby ")) {
+        return MessageType::Lobby;
+    }
+    if (message.startsWith(sessionCreatedPrefix) or message.startsWith(connectedPrefix)) {
+        return MessageType::Session;
+    }
+    if (message.contains(u"Your board:")) {
+        return MessageType::Board;
+    }
+    if (message == u"Your turn") {
+        return MessageType::Turn;
+    }
+    if (message.startsWith(shotResultPrefix)) {
+        return MessageType::ShotResult;
+    }
+    if (message.startsWith(opponentShotPrefix)) {
+        return MessageType::OpponentShot;
+    }
+    if (message.startsWith(u"Game over:")) {
+        return MessageType::GameOver;
+    }
+    return MessageType::Other;
+}
 }
 
 MainWindow::MainWindow(QWidget* parent)
     : QMainWindow(parent)
-    , webSocketToGame(new QWebSocket(QString(), QWebSocketProtocol::VersionLatest, this))
+    , transportToGame(Transport::create(serverUrl(), this))
     , centralWidgetGame(new QWidget(this))
     , mainLayoutGame(new QVBoxLayout(centralWidgetGame))
+    , lobbyModel(new LobbyModel(this))
     , gameBoardForPlay(new GameBoard(this))
+    , resyncTimer(new QTimer(this))
     , lastSentMessageIs("")
-    , isTestingFlag(false) {
+    , isTestingFlag(false)
+    , gameHistoryStore(HistoryStore::defaultFilePath())
+    , yourTurnStatus(tr(yourTurnText))
+    , opponentTurnStatus(tr(opponentTurnText))
+    , sessionSnapshot(SessionSnapshot::defaultFilePath()) {
     setCentralWidget(centralWidgetGame);
     setWindowTitle(tr("Игра морской бой"));
     resize(defaultWindowSize);
 
-    connect(webSocketToGame, &QWebSocket::connected, this, &MainWindow::onConnected);
-    connect(webSocketToGame, &QWebSocket::disconnected, this, &MainWindow::onDisconnected);
-    connect(webSocketToGame, &QWebSocket::textMessageReceived, this, &MainWindow::onTextMessageReceived);
+    connect(transportToGame, &Transport::connected, this, &MainWindow::onConnected);
+    connect(transportToGame, &Transport::disconnected, this, &MainWindow::onDisconnected);
+    connect(transportToGame, &Transport::textMessageReceived, this, &MainWindow::onTextMessageReceived);
     connect(gameBoardForPlay, &GameBoard::cellClicked, this, &MainWindow::onCellClicked);
+    resyncTimer->setSingleShot(true);
+    resyncTimer->setInterval(resyncRetryMs);
+    connect(resyncTimer, &QTimer::timeout, this, [this] {
+        if (resumePending) {
+            sendResume();
+        } else {
+            sendResync();
+        }
+    });
+    connect(gameBoardForPlay, &GameBoard::cellChanged, this,
+            [this](GameHistory::Board board, int x, int y, char cell) { sessionSnapshot.setCell(board, x, y, cell); });
 
-    webSocketToGame->open(QUrl(webSocketUrl));
+    transportToGame->open(serverUrl());
 
+    const std::optional<SessionSnapshot::State> savedGame = sessionSnapshot.restore();
     setupMainMenu();
+    if (savedGame) {
+        resumeGame(*savedGame);
+    }
+
+    perfHud = new PerfHud(this, gameBoardForPlay);
+    auto* perfHudToggle = new QShortcut(QKeySequence(perfHudShortcut), this);
+    connect(perfHudToggle, &QShortcut::activated, perfHud, &PerfHud::toggle);
+    if (qEnvironmentVariableIsSet(perfHudVariable)) {
+        perfHud->show();
+    }
 }
 
 MainWindow::~MainWindow() {
     isClosing = true;
-    if (webSocketToGame->state() != QAbstractSocket::UnconnectedState) {
-        webSocketToGame->close();
-    }
+    transportToGame->close();
 }
 
 void MainWindow::setupMainMenu() {
@@ -61,6 +169,8 @@ void MainWindow::setupMainMenu() {
     }
     isSettingUpMainMenu = true;
 
+    leaveLobby();
+
     gameBoardForPlay->cleanFiledForNewGame();
     gameBoardForPlay->setOpponentBoardClickOrNot(false);
     gameBoardForPlay->getPlayerWidget()->setVisible(false);
@@ -77,6 +187,20 @@ void MainWindow::setupMainMenu() {
     mainLayoutGame->addWidget(createButton);
     mainLayoutGame->addWidget(joinButton);
 
+    if (!gameBoardForPlay->history().isEmpty()) {
+        reviewButton = new QPushButton(tr(reviewGameText), this);
+        mainLayoutGame->addWidget(reviewButton);
+        connect(reviewButton, &QPushButton::clicked, this, &MainWindow::onReviewGameClicked);
+    }
+
+    lobbyButton = new QPushButton(tr(lobbyText), this);
+    mainLayoutGame->addWidget(lobbyButton);
+    connect(lobbyButton, &QPushButton::clicked, this, &MainWindow::onLobbyClicked);
+
+    statisticsButton = new QPushButton(tr(statisticsText), this);
+    mainLayoutGame->addWidget(statisticsButton);
+    connect(statisticsButton, &QPushButton::clicked, this, &MainWindow::onStatisticsClicked);
+
     statusLabel = new QLabel(tr(askingToConnectText), this);
     mainLayoutGame->addWidget(statusLabel);
     mainLayoutGame->addStretch();
@@ -86,6 +210,10 @@ void MainWindow::setupMainMenu() {
     connect(gameBoardForPlay, &GameBoard::cellClicked, this, &MainWindow::onCellClicked);
 
     isMyTurn = false;
+    resyncPending = false;
+    resyncTimer->stop();
+    resumePending = false;
+    sessionSnapshot.clear();
     lastShotX = -1;
     lastShotY = -1;
     currentSessionId.clear();
@@ -148,6 +276,7 @@ void MainWindow::setupGameBoardWhenTwoPlayersAreConnected() {
 }
 
 void MainWindow::clearLayout() {
+    gameBoardForPlay->detachWidgets();
     while (auto* item = mainLayoutGame->takeAt(0)) {
         if (auto* widget = item->widget()) {
             widget->disconnect();
@@ -169,6 +298,10 @@ void MainWindow::clearLayout() {
     sessionIdInput = nullptr;
     createButton = nullptr;
     joinButton = nullptr;
+    reviewButton = nullptr;
+    statisticsButton = nullptr;
+    lobbyButton = nullptr;
+    lobbyWidget = nullptr;
 }
 
 void MainWindow::onCreateSessionClicked() {
@@ -184,7 +317,7 @@ void MainWindow::onCreateSessionClicked() {
     }
     currentSessionId = sessionId;
     lastSentMessageIs = QString("create:%1").arg(sessionId);
-    webSocketToGame->sendTextMessage(lastSentMessageIs);
+    transportToGame->sendTextMessage(lastSentMessageIs);
 }
 
 void MainWindow::onJoinSessionClicked() {
@@ -200,10 +333,54 @@ void MainWindow::onJoinSessionClicked() {
     }
     currentSessionId = sessionId;
     lastSentMessageIs = QString("join:%1").arg(sessionId);
-    webSocketToGame->sendTextMessage(lastSentMessageIs);
+    transportToGame->sendTextMessage(lastSentMessageIs);
+}
+
+void MainWindow::onReviewGameClicked() {
+    auto* scrubber = new TimelineScrubber(gameBoardForPlay->history(), this);
+    scrubber->setWindowFlag(Qt::Window);
+    scrubber->setAttribute(Qt::WA_DeleteOnClose);
+    scrubber->show();
+}
+
+void MainWindow::onStatisticsClicked() {
+    auto* statsWidget = new StatsWidget(gameHistoryStore.statistics(), this);
+    statsWidget->setWindowFlag(Qt::Window);
+    statsWidget->setAttribute(Qt::WA_DeleteOnClose);
+    statsWidget->show();
+}
+
+void MainWindow::onLobbyClicked() {
+    clearLayout();
+
+    lobbyWidget = new LobbyWidget(lobbyModel, this);
+    mainLayoutGame->addWidget(lobbyWidget);
+    connect(lobbyWidget, &LobbyWidget::sessionChosen, this, [this](const QString& sessionId) {
+        leaveLobby();
+        currentSessionId = sessionId;
+        lastSentMessageIs = QString("join:%1").arg(sessionId);
+        transportToGame->sendTextMessage(lastSentMessageIs);
+    });
+    connect(lobbyWidget, &LobbyWidget::backRequested, this, &MainWindow::setupMainMenu, Qt::QueuedConnection);
+
+    transportToGame->sendTextMessage(lobbySubscribeCommand);
+}
+
+void MainWindow::leaveLobby() {
+    if (!lobbyWidget) {
+        return;
+    }
+    lobbyWidget = nullptr;
+    lobbyModel->clear();
+    transportToGame->sendTextMessage(lobbyUnsubscribeCommand);
 }
 
 void MainWindow::onConnected() {
+    if (resumePending) {
+        resyncAttempts = 0;
+        sendResume();
+        return;
+    }
     if (statusLabel) {
         statusLabel->setText(tr("Подключено к серверу"));
     }
@@ -219,39 +396,64 @@ void MainWindow::onDisconnected() {
     setupMainMenu();
 }
 
-void MainWindow::onTextMessageReceived(const QString& message) {
+void MainWindow::onTextMessageReceived(const QString& rawMessage) {
+    QStringView message = rawMessage;
+    const std::optional<quint64> frameHash = takeFrameHash(message);
+    const AllocationLedger::MessageType messageType = messageTypeOf(message);
+    {
+        const AllocationLedger::Scope accounting(allocationLedger, messageType);
+        dispatchMessage(message, rawMessage, frameHash);
+    }
+    sessionSnapshot.setMyTurn(isMyTurn);
+    if (messageType == AllocationLedger::MessageType::GameOver) {
+        reportAllocations();
+    }
+}
 
-    if (message.startsWith("Session created:")) {
-        currentSessionId = message.mid(QString("Session created: ").length()).trimmed();
+void MainWindow::dispatchMessage(QStringView message, const QString& rawMessage, std::optional<quint64> frameHash) {
+    const auto messageText = [&] { return message.size() == rawMessage.size() ? rawMessage : message.toString(); };
+
+    if (message.startsWith(u"Lobby ")) {
+        lobbyModel->applyMessage(messageText());
+    } else if (message.startsWith(sessionCreatedPrefix)) {
+        currentSessionId = message.mid(sessionCreatedPrefix.size()).trimmed().toString();
         if (!statusLabel) {
             setupMainMenu();
             return;
         }
         waitSecondPlayer();
-    } else if (message.startsWith("Connected to session:")) {
-        currentSessionId =
-            message.mid(QString("Connected to session: ").length()).split('\n').first().trimmed();
-        if (message.contains("Your board:")) {
-            gameBoardForPlay->parseAndSaveBoard(message);
-            setupGameBoardWhenTwoPlayersAreConnected();
+    } else if (message.startsWith(connectedPrefix)) {
+        const QStringView rest = message.mid(connectedPrefix.size());
+        currentSessionId = rest.left(rest.indexOf(u'\n')).trimmed().toString();
+        if (message.contains(u"Your board:")) {
+            startGame(messageText());
         } else {
             waitSecondPlayer();
         }
-    } else if (message.contains("Your board:")) {
-        gameBoardForPlay->parseAndSaveBoard(message);
-        setupGameBoardWhenTwoPlayersAreConnected();
-    } else if (message == "Your turn") {
+    } else if (message.contains(u"Your board:") and (resyncPending or resumePending)) {
+        resyncPending = false;
+        resumePending = false;
+        resyncTimer->stop();
+        gameBoardForPlay->resyncBoards(messageText());
+        reconcileSummaryWithBoards();
+        storeSnapshot(sessionSnapshot.sequence());
+    } else if (message.contains(u"Your board:")) {
+        startGame(messageText());
+    } else if (message == u"Your turn") {
         isMyTurn = true;
         gameBoardForPlay->setOpponentBoardClickOrNot(true);
         if (statusLabel) {
-            statusLabel->setText(tr(yourTurnText));
+            statusLabel->setText(yourTurnStatus);
         }
-    } else if (message.startsWith("Shot result:")) {
+    } else if (message.startsWith(shotResultPrefix)) {
         processShotResult(message);
-    } else if (message.startsWith("Opponent shot at")) {
+        verifyBoardHash(frameHash);
+    } else if (message.startsWith(opponentShotPrefix)) {
         processOpponentShot(message);
-    } else if (message == "Game over: You win!" || message == "Game over: You lose!") {
-        const bool gameResult = message.contains("win");
+        verifyBoardHash(frameHash);
+    } else if (message == u"Game over: You win!" || message == u"Game over: You lose!") {
+        const bool gameResult = message.contains(u"win");
+        recordFinishedGame(gameResult);
         setupMainMenu();
 
         if (!isTestingFlag) {
@@ -263,46 +465,175 @@ void MainWindow::onTextMessageReceived(const QString& message) {
     }
 }
 
+void MainWindow::startGame(const QString& boardMessage) {
+    allocationLedger.reset();
+    currentGameSummary = HistoryStore::GameSummary();
+    gameBoardForPlay->parseAndSaveBoard(boardMessage);
+    setupGameBoardWhenTwoPlayersAreConnected();
+    storeSnapshot(0);
+}
+
+void MainWindow::resumeGame(const SessionSnapshot::State& savedGame) {
+    currentSessionId = savedGame.sessionId;
+    isMyTurn = savedGame.myTurn;
+    gameBoardForPlay->restoreBoards(savedGame.openingBoard, savedGame.playerBoard, savedGame.opponentBoard);
+    setupGameBoardWhenTwoPlayersAreConnected();
+    statusLabel->setText(isMyTurn ? yourTurnStatus : opponentTurnStatus);
+    sessionSnapshot.store(savedGame);
+
+    resumePending = true;
+    if (transportToGame->isConnected()) {
+        onConnected();
+    }
+}
+
+void MainWindow::storeSnapshot(std::uint64_t sequence) {
+    sessionSnapshot.store({currentSessionId, gameBoardForPlay->openingBoard(), gameBoardForPlay->playerBoardFirst,
+                           gameBoardForPlay->opponentBoardSecond, isMyTurn, sequence});
+}
+
 void MainWindow::onCellClicked(int x, int y) {
     if (!isMyTurn) {
         return;
     }
+    const QString& command = commandEncoder.shoot(x, y);
+    if (command.isEmpty()) {
+        return;
+    }
+    const AllocationLedger::Scope accounting(allocationLedger, AllocationLedger::MessageType::Shoot);
     lastShotX = x;
     lastShotY = y;
-    webSocketToGame->sendTextMessage(QString("shoot %1 %2").arg(x).arg(y));
-}
-
-void MainWindow::processShotResult(const QString& message) {
-    static const QRegularExpression re{"Shot result: (\\w+)"};
-    const QRegularExpressionMatch match = re.match(message);
-    if (match.hasMatch() && lastShotX >= 0 && lastShotY >= 0) {
-        const QString result = match.captured(1);
-        gameBoardForPlay->updateOpponentBoard(lastShotX, lastShotY, result);
-        if (result == "hit" || result == "kill") {
-            isMyTurn = true;
-            gameBoardForPlay->setOpponentBoardClickOrNot(true);
-            if (statusLabel) {
-                statusLabel->setText(tr(yourTurnText));
+    transportToGame->sendTextMessage(command);
+}
+
+void MainWindow::processShotResult(QStringView message) {
+    const QStringView result = leadingWord(message.mid(shotResultPrefix.size()).trimmed());
+    if (result.isEmpty()) {
+        return;
+    }
+    if (lastShotX < 0 || lastShotY < 0) {
+        requestResync();
+        return;
+    }
+    gameBoardForPlay->updateOpponentBoard(lastShotX, lastShotY, result);
+    if (currentGameSummary.firstShotCell < 0) {
+        currentGameSummary.firstShotCell = lastShotX * boardSide + lastShotY;
+    }
+    currentGameSummary.shotsFired++;
+    if (result == u"hit" || result == u"kill") {
+        currentGameSummary.shotsHit++;
+        isMyTurn = true;
+        gameBoardForPlay->setOpponentBoardClickOrNot(true);
+        if (statusLabel) {
+            statusLabel->setText(yourTurnStatus);
+        }
+    } else if (result == u"miss") {
+        isMyTurn = false;
+        gameBoardForPlay->setOpponentBoardClickOrNot(false);
+        if (statusLabel) {
+            statusLabel->setText(opponentTurnStatus);
+        }
+    }
+    lastShotX = -1;
+    lastShotY = -1;
+}
+
+void MainWindow::processOpponentShot(QStringView message) {
+    const QStringView rest = message.mid(opponentShotPrefix.size());
+    const qsizetype comma = rest.indexOf(u", ");
+    const qsizetype close = rest.indexOf(u"): ");
+    if (!rest.startsWith(u'(') or comma < 0 or close < comma) {
+        return;
+    }
+    bool xParsed = false;
+    bool yParsed = false;
+    const int x = rest.mid(1, comma - 1).toInt(&xParsed);
+    const int y = rest.mid(comma + 2, close - comma - 2).toInt(&yParsed);
+    const QStringView result = leadingWord(rest.mid(close + 3));
+    if (!xParsed or !yParsed or result.isEmpty()) {
+        return;
+    }
+    gameBoardForPlay->updatePlayerBoard(x, y, result);
+    if (x >= 0 && x < boardSide && y >= 0 && y < boardSide) {
+        currentGameSummary.opponentShots.set(x * boardSide + y);
+    }
+}
+
+void MainWindow::verifyBoardHash(std::optional<quint64> frameHash) {
+    if (!frameHash or *frameHash == gameBoardForPlay->boardHash()) {
+        return;
+    }
+    requestResync();
+}
+
+void MainWindow::requestResync() {
+    if (resyncPending or currentSessionId.isEmpty()) {
+        return;
+    }
+    resyncPending = true;
+    resyncAttempts = 0;
+    sendResync();
+}
+
+void MainWindow::sendResync() {
+    if (!resyncPending) {
+        return;
+    }
+    if (resyncAttempts >= maxResyncAttempts) {
+        resyncPending = false;
+        return;
+    }
+    resyncAttempts++;
+    transportToGame->sendTextMessage(QString(resyncCommand).arg(currentSessionId));
+    resyncTimer->start();
+}
+
+void MainWindow::sendResume() {
+    if (!resumePending) {
+        return;
+    }
+    if (resyncAttempts >= maxResyncAttempts) {
+        setupMainMenu();
+        return;
+    }
+    resyncAttempts++;
+    transportToGame->sendTextMessage(QString(resumeCommand).arg(currentSessionId).arg(sessionSnapshot.sequence()));
+    resyncTimer->start();
+}
+
+void MainWindow::reconcileSummaryWithBoards() {
+    int shotsMarked = 0;
+    int hitsMarked = 0;
+    for (int x = 0; x < boardSide; ++x) {
+        for (int y = 0; y < boardSide; ++y) {
+            const char opponentCell = gameBoardForPlay->opponentBoardSecond[x][y];
+            if (opponentCell == boardcell::hit or opponentCell == boardcell::miss) {
+                shotsMarked++;
+                hitsMarked += opponentCell == boardcell::hit ? 1 : 0;
             }
-        } else if (result == "miss") {
-            isMyTurn = false;
-            gameBoardForPlay->setOpponentBoardClickOrNot(false);
-            if (statusLabel) {
-                statusLabel->setText(tr(opponentTurnText));
+            const char playerCell = gameBoardForPlay->playerBoardFirst[x][y];
+            if (playerCell == boardcell::hit or playerCell == boardcell::miss) {
+                currentGameSummary.opponentShots.set(x * boardSide + y);
             }
         }
-        lastShotX = -1;
-        lastShotY = -1;
     }
+    currentGameSummary.shotsFired = std::max(currentGameSummary.shotsFired, shotsMarked);
+    currentGameSummary.shotsHit = std::max(currentGameSummary.shotsHit, hitsMarked);
+}
+
+void MainWindow::reportAllocations() {
+    if (allocationcounter::isEnabled()) {
+        qInfo().noquote() << allocationLedger.report();
+    }
+    allocationLedger.reset();
 }
 
-void MainWindow::processOpponentShot(const QString& message) {
-    static const QRegularExpression re{R"(Opponent shot at \((\d+), (\d+)\): (\w+))"};
-    const QRegularExpressionMatch match = re.match(message);
-    if (match.hasMatch()) {
-        const int x = match.captured(1).toInt();
-        const int y = match.captured(2).toInt();
-        const QString result = match.captured(3);
-        gameBoardForPlay->updatePlayerBoard(x, y, result);
+void MainWindow::recordFinishedGame(bool won) {
+    if (isTestingFlag) {
+        return;
     }
+    currentGameSummary.won = won;
+    currentGameSummary.finishedAtMs = QDateTime::currentMSecsSinceEpoch();
+    gameHistoryStore.append(currentGameSummary);
+    currentGameSummary = HistoryStore::GameSummary();
 }
\ No newline at end of file
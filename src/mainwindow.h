@@ -6,10 +6,19 @@
 #include <QMainWindow>
 #include <QPushButton>
 #include <QString>
+#include <QTimer>
 #include <QVBoxLayout>
-#include <QWebSocket>
+#include <optional>
 
+#include "allocationledger.h"
+#include "commandencoder.h"
 #include "gameboard.h"
+#include "historystore.h"
+#include "lobbymodel.h"
+#include "lobbywidget.h"
+#include "perfhud.h"
+#include "sessionsnapshot.h"
+#include "transport.h"
 
 class MainWindow : public QMainWindow {
     Q_OBJECT
@@ -20,39 +29,72 @@ public:
 
     QString getLastSentMessage() const { return lastSentMessageIs; }
     void setTestingMode(bool testing) { isTestingFlag = testing; }
+    const AllocationLedger& getAllocationLedger() const { return allocationLedger; }
 
     public slots:
         void onCreateSessionClicked();
     void onJoinSessionClicked();
     void onConnected();
     void onDisconnected();
-    void onTextMessageReceived(const QString& message);
+    void onTextMessageReceived(const QString& rawMessage);
     void onCellClicked(int x, int y);
+    void onReviewGameClicked();
+    void onStatisticsClicked();
+    void onLobbyClicked();
 
 private:
     void setupMainMenu();
+    void leaveLobby();
     void waitSecondPlayer();
     void setupGameBoardWhenTwoPlayersAreConnected();
     void clearLayout();
-    void processShotResult(const QString& message);
-    void processOpponentShot(const QString& message);
+    void dispatchMessage(QStringView message, const QString& rawMessage, std::optional<quint64> frameHash);
+    void startGame(const QString& boardMessage);
+    void resumeGame(const SessionSnapshot::State& savedGame);
+    void storeSnapshot(std::uint64_t sequence);
+    void processShotResult(QStringView message);
+    void processOpponentShot(QStringView message);
+    void verifyBoardHash(std::optional<quint64> frameHash);
+    void requestResync();
+    void sendResync();
+    void sendResume();
+    void reconcileSummaryWithBoards();
+    void recordFinishedGame(bool won);
+    void reportAllocations();
 
-    QWebSocket* webSocketToGame = nullptr;
+    Transport* transportToGame = nullptr;
     QWidget* centralWidgetGame = nullptr;
     QVBoxLayout* mainLayoutGame = nullptr;
     QLabel* statusLabel = nullptr;
     QLineEdit* sessionIdInput = nullptr;
     QPushButton* createButton = nullptr;
     QPushButton* joinButton = nullptr;
+    QPushButton* reviewButton = nullptr;
+    QPushButton* statisticsButton = nullptr;
+    QPushButton* lobbyButton = nullptr;
+    LobbyWidget* lobbyWidget = nullptr;
+    LobbyModel* lobbyModel = nullptr;
     GameBoard* gameBoardForPlay = nullptr;
+    PerfHud* perfHud = nullptr;
+    QTimer* resyncTimer = nullptr;
     QString currentSessionId;
     bool isMyTurn = false;
+    bool resyncPending = false;
+    int resyncAttempts = 0;
+    bool resumePending = false;
     int lastShotX = -1;
     int lastShotY = -1;
     bool isSettingUpMainMenu = false;
     bool isClosing = false;
     QString lastSentMessageIs;
     bool isTestingFlag = false;
+    HistoryStore gameHistoryStore;
+    HistoryStore::GameSummary currentGameSummary;
+    QString yourTurnStatus;
+    QString opponentTurnStatus;
+    CommandEncoder commandEncoder;
+    AllocationLedger allocationLedger;
+    SessionSnapshot sessionSnapshot;
 };
 
 #endif
\ No newline at end of file
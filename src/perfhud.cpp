@@ -0,0 +1,256 @@
+#include "perfhud.h"
+
+#include <QApplication>
+#include <QPainter>
+#include <algorithm>
+
+#include "allocationcounter.h"
+
+namespace {
+constexpr int maxFrames = 120;
+constexpr int graphBarWidth = 2;
+constexpr int graphHeight = 60;
+constexpr int hudPadding = 6;
+constexpr int hudMargin = 8;
+constexpr int hudTextLines = 6;
+constexpr int refreshIntervalMs = 250;
+constexpr qint64 frameBudgetNs = 16'666'667;
+constexpr qint64 graphRangeNs = frameBudgetNs * 2;
+constexpr double nsPerMs = 1'000'000.0;
+const QColor hudBackground{0, 0, 0, 190};
+const QColor frameBarColor{90, 200, 90};
+const QColor slowFrameBarColor{220, 70, 70};
+const QColor paintBarColor{80, 150, 240};
+const QColor budgetLineColor{255, 255, 255, 120};
+
+struct TreeCount {
+    int widgets = 0;
+    int objects = 0;
+};
+
+TreeCount countTree(const QObject* root) {
+    TreeCount count;
+    if (!root) {
+        return count;
+    }
+    const QList<QObject*> children = root->findChildren<QObject*>();
+    count.objects = 1 + static_cast<int>(children.size());
+    count.widgets = root->isWidgetType() ? 1 : 0;
+    for (const QObject* child : children) {
+        count.widgets += child->isWidgetType() ? 1 : 0;
+    }
+    return count;
+}
+
+double toMs(qint64 ns) {
+    return static_cast<double>(ns) / nsPerMs;
+}
+}
+
+PerfHud::PerfHud(QWidget* window, GameBoard* gameBoard)
+    : QWidget(window)
+    , hostWindow(window)
+    , watchedBoard(gameBoard) {
+    setAttribute(Qt::WA_TransparentForMouseEvents);
+    setFixedSize(maxFrames * graphBarWidth + hudPadding * 2,
+                 fontMetrics().height() * hudTextLines + graphHeight + hudPadding * 3);
+
+    refreshTimer.setInterval(refreshIntervalMs);
+    connect(&refreshTimer, &QTimer::timeout, this, &PerfHud::refresh);
+    connect(watchedBoard, &GameBoard::frameRendered, this, &PerfHud::onBoardFrame);
+    hide();
+}
+
+PerfHud::~PerfHud() {
+    qApp->removeEventFilter(this);
+}
+
+void PerfHud::toggle() {
+    setVisible(!isVisible());
+}
+
+PerfHud::ObjectCounts PerfHud::objectCounts() const {
+    ObjectCounts counts;
+    const QObject* boardRoots[] = {watchedBoard, watchedBoard->getPlayerWidget(), watchedBoard->getOpponentWidget()};
+    for (const QObject* root : boardRoots) {
+        const TreeCount count = countTree(root);
+        counts.gameBoardWidgets += count.widgets;
+        counts.gameBoardObjects += count.objects;
+    }
+    const TreeCount window = countTree(hostWindow);
+    const TreeCount hud = countTree(this);
+    counts.mainWindowWidgets = window.widgets - hud.widgets;
+    counts.mainWindowObjects = window.objects - hud.objects;
+    return counts;
+}
+
+bool PerfHud::eventFilter(QObject* watched, QEvent* event) {
+    const bool boardPaint = event->type() == QEvent::Paint and isBoardWidget(watched);
+    if (!boardPaint) {
+        finishBoardPaint();
+    }
+    switch (event->type()) {
+        case QEvent::UpdateRequest:
+            if (watched == hostWindow->window() and !windowFrameTimer.isValid()) {
+                windowFrameTimer.start();
+                QMetaObject::invokeMethod(this, &PerfHud::finishWindowFrame, Qt::QueuedConnection);
+            }
+            break;
+        case QEvent::Paint:
+            if (boardPaint and !boardPaintTimer.isValid()) {
+                boardPaintTimer.start();
+            }
+            break;
+        case QEvent::StyleChange:
+            if (watched != this) {
+                ++pendingFrame.repolishes;
+            }
+            break;
+        case QEvent::Resize:
+            if (watched == hostWindow) {
+                placeInWindow();
+            }
+            break;
+        default:
+            break;
+    }
+    return false;
+}
+
+void PerfHud::showEvent(QShowEvent* event) {
+    QWidget::showEvent(event);
+    qApp->installEventFilter(this);
+    startSampling();
+    shownCounts = objectCounts();
+    placeInWindow();
+    raise();
+    refreshTimer.start();
+}
+
+void PerfHud::hideEvent(QHideEvent* event) {
+    QWidget::hideEvent(event);
+    qApp->removeEventFilter(this);
+    refreshTimer.stop();
+    windowFrameTimer.invalidate();
+    boardPaintTimer.invalidate();
+}
+
+void PerfHud::paintEvent(QPaintEvent*) {
+    QElapsedTimer elapsed;
+    elapsed.start();
+
+    QPainter painter(this);
+    painter.fillRect(rect(), hudBackground);
+    painter.setPen(Qt::white);
+
+    const FrameSample last = frames.empty() ? FrameSample() : frames.back();
+    const QString allocationsLine = allocationcounter::isEnabled()
+                                        ? tr("Выделений памяти: %1").arg(last.allocations)
+                                        : tr("Счётчик выделений отключён");
+    const QStringList lines{
+        tr("Кадр: %1 мс (обновление %2 мс)").arg(toMs(last.frameNs), 0, 'f', 2).arg(toMs(last.updateNs), 0, 'f', 2),
+        tr("Отрисовка полей: %1 мс").arg(toMs(last.boardPaintNs), 0, 'f', 2),
+        tr("Перерисовки стилей: %1").arg(last.repolishes),
+        allocationsLine,
+        tr("Поле: %1 виджетов, %2 объектов").arg(shownCounts.gameBoardWidgets).arg(shownCounts.gameBoardObjects),
+        tr("Окно: %1 виджетов, %2 объектов").arg(shownCounts.mainWindowWidgets).arg(shownCounts.mainWindowObjects),
+    };
+    const int lineHeight = fontMetrics().height();
+    int baseline = hudPadding + fontMetrics().ascent();
+    for (const QString& line : lines) {
+        painter.drawText(hudPadding, baseline, line);
+        baseline += lineHeight;
+    }
+
+    drawGraph(painter, QRect(hudPadding, height() - hudPadding - graphHeight, maxFrames * graphBarWidth, graphHeight));
+    hudPaintNs += elapsed.nsecsElapsed();
+}
+
+bool PerfHud::isBoardWidget(QObject* object) const {
+    if (!object->isWidgetType()) {
+        return false;
+    }
+    const auto* widget = static_cast<QWidget*>(object);
+    return watchedBoard->getPlayerWidget()->isAncestorOf(widget) or
+           watchedBoard->getOpponentWidget()->isAncestorOf(widget);
+}
+
+void PerfHud::finishBoardPaint() {
+    if (boardPaintTimer.isValid()) {
+        pendingFrame.boardPaintNs += boardPaintTimer.nsecsElapsed();
+        boardPaintTimer.invalidate();
+    }
+}
+
+void PerfHud::finishWindowFrame() {
+    if (!windowFrameTimer.isValid()) {
+        return;
+    }
+    finishBoardPaint();
+    const qint64 windowFrameNs = windowFrameTimer.nsecsElapsed();
+    windowFrameTimer.invalidate();
+    commitFrame(windowFrameNs);
+}
+
+void PerfHud::onBoardFrame(qint64 elapsedNs) {
+    pendingFrame.updateNs += elapsedNs;
+}
+
+void PerfHud::commitFrame(qint64 windowFrameNs) {
+    const bool boardActivity =
+        pendingFrame.updateNs > 0 or pendingFrame.boardPaintNs > 0 or pendingFrame.repolishes > 0;
+    if (boardActivity) {
+        pendingFrame.frameNs = pendingFrame.updateNs + std::max<qint64>(0, windowFrameNs - hudPaintNs);
+        pendingFrame.allocations = allocationcounter::allocationCount() - allocationsAtFrameStart;
+        frames.push_back(pendingFrame);
+        if (static_cast<int>(frames.size()) > maxFrames) {
+            frames.pop_front();
+        }
+        framesChanged = true;
+    }
+    startSampling();
+}
+
+void PerfHud::startSampling() {
+    pendingFrame = FrameSample();
+    hudPaintNs = 0;
+    allocationsAtFrameStart = allocationcounter::allocationCount();
+}
+
+void PerfHud::refresh() {
+    const ObjectCounts counts = objectCounts();
+    const bool countsChanged = counts.gameBoardObjects != shownCounts.gameBoardObjects or
+                               counts.mainWindowObjects != shownCounts.mainWindowObjects or
+                               counts.gameBoardWidgets != shownCounts.gameBoardWidgets or
+                               counts.mainWindowWidgets != shownCounts.mainWindowWidgets;
+    if (!framesChanged and !countsChanged) {
+        return;
+    }
+    shownCounts = counts;
+    framesChanged = false;
+    update();
+}
+
+void PerfHud::placeInWindow() {
+    move(hostWindow->width() - width() - hudMargin, hudMargin);
+}
+
+void PerfHud::drawGraph(QPainter& painter, const QRect& area) const {
+    const auto barHeight = [&area](qint64 ns) {
+        return static_cast<int>(std::min(ns, graphRangeNs) * area.height() / graphRangeNs);
+    };
+
+    int x = area.right() + 1 - static_cast<int>(frames.size()) * graphBarWidth;
+    for (const FrameSample& frame : frames) {
+        const int frameHeight = barHeight(frame.frameNs);
+        const int paintHeight = std::min(barHeight(frame.boardPaintNs), frameHeight);
+        painter.fillRect(x, area.bottom() + 1 - frameHeight, graphBarWidth, frameHeight,
+                         frame.frameNs > frameBudgetNs ? slowFrameBarColor : frameBarColor);
+        painter.fillRect(x, area.bottom() + 1 - paintHeight, graphBarWidth, paintHeight, paintBarColor);
+        x += graphBarWidth;
+    }
+
+    const int budgetY = area.bottom() + 1 - barHeight(frameBudgetNs);
+    painter.setPen(budgetLineColor);
+    painter.drawLine(area.left(), budgetY, area.right(), budgetY);
+}
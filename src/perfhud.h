@@ -0,0 +1,67 @@
+#ifndef PERFHUD_H
+#define PERFHUD_H
+
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QWidget>
+#include <deque>
+
+#include "gameboard.h"
+
+class PerfHud : public QWidget {
+    Q_OBJECT
+
+public:
+    struct FrameSample {
+        qint64 frameNs = 0;
+        qint64 updateNs = 0;
+        qint64 boardPaintNs = 0;
+        int repolishes = 0;
+        quint64 allocations = 0;
+    };
+
+    struct ObjectCounts {
+        int gameBoardWidgets = 0;
+        int gameBoardObjects = 0;
+        int mainWindowWidgets = 0;
+        int mainWindowObjects = 0;
+    };
+
+    PerfHud(QWidget* window, GameBoard* gameBoard);
+    ~PerfHud() override;
+
+    void toggle();
+    const std::deque<FrameSample>& recentFrames() const { return frames; }
+    ObjectCounts objectCounts() const;
+
+protected:
+    bool eventFilter(QObject* watched, QEvent* event) override;
+    void showEvent(QShowEvent* event) override;
+    void hideEvent(QHideEvent* event) override;
+    void paintEvent(QPaintEvent* event) override;
+
+private:
+    bool isBoardWidget(QObject* object) const;
+    void finishBoardPaint();
+    void finishWindowFrame();
+    void onBoardFrame(qint64 elapsedNs);
+    void commitFrame(qint64 windowFrameNs);
+    void startSampling();
+    void refresh();
+    void placeInWindow();
+    void drawGraph(QPainter& painter, const QRect& area) const;
+
+    QWidget* hostWindow = nullptr;
+    GameBoard* watchedBoard = nullptr;
+    std::deque<FrameSample> frames;
+    FrameSample pendingFrame;
+    quint64 allocationsAtFrameStart = 0;
+    qint64 hudPaintNs = 0;
+    QElapsedTimer windowFrameTimer;
+    QElapsedTimer boardPaintTimer;
+    ObjectCounts shownCounts;
+    bool framesChanged = false;
+    QTimer refreshTimer;
+};
+
+#endif
@@ -0,0 +1,215 @@
+#include "sessionsnapshot.h"
+
+#include <QDir>
+#include <QStandardPaths>
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+
+#include "boardcell.h"
+
+namespace {
+constexpr std::uint32_t snapshotMagic = 0x53425353;
+constexpr std::uint32_t snapshotVersion = 2;
+constexpr int cellsPerByte = 4;
+constexpr int bitsPerCell = 2;
+constexpr int packedBoardBytes = SessionSnapshot::SIZE * SessionSnapshot::SIZE / cellsPerByte;
+constexpr std::uint8_t cellMask = 0b11;
+constexpr auto snapshotFileName = "session.snapshot";
+
+// Single fixed-size record, rewritten in place. Cell and turn updates are single-byte
+// stores; a cell is always written before the sequence number so a crash in between
+// only means the event is applied twice, which is idempotent.
+struct Record {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint64_t sequence;
+    std::uint8_t active;
+    std::uint8_t myTurn;
+    std::uint8_t sessionIdLength;
+    std::uint8_t reserved[5];
+    char sessionId[SessionSnapshot::maxSessionIdBytes];
+    std::uint8_t playerCells[packedBoardBytes];
+    std::uint8_t opponentCells[packedBoardBytes];
+    std::uint8_t openingCells[packedBoardBytes];
+    std::uint8_t padding[5];
+};
+
+static_assert(sizeof(Record) == 168);
+static_assert(std::is_trivially_copyable_v<Record>);
+
+std::uint8_t encodeCell(char cell) {
+    switch (cell) {
+        case boardcell::ship:
+            return 1;
+        case boardcell::miss:
+            return 2;
+        case boardcell::hit:
+            return 3;
+        default:
+            return 0;
+    }
+}
+
+char decodeCell(std::uint8_t code) {
+    constexpr char cells[] = {boardcell::empty, boardcell::ship, boardcell::miss, boardcell::hit};
+    return cells[code & cellMask];
+}
+
+void packCell(std::uint8_t* packed, int index, char cell) {
+    const int shift = (index % cellsPerByte) * bitsPerCell;
+    std::uint8_t& byte = packed[index / cellsPerByte];
+    byte = static_cast<std::uint8_t>((byte & ~(cellMask << shift)) | (encodeCell(cell) << shift));
+}
+
+void packBoard(std::uint8_t* packed, const SessionSnapshot::Cells& board) {
+    std::memset(packed, 0, packedBoardBytes);
+    for (int i = 0; i < SessionSnapshot::SIZE and i < static_cast<int>(board.size()); ++i) {
+        for (int j = 0; j < SessionSnapshot::SIZE and j < static_cast<int>(board[i].size()); ++j) {
+            packCell(packed, i * SessionSnapshot::SIZE + j, board[i][j]);
+        }
+    }
+}
+
+SessionSnapshot::Cells unpackBoard(const std::uint8_t* packed) {
+    SessionSnapshot::Cells board(SessionSnapshot::SIZE, std::vector<char>(SessionSnapshot::SIZE));
+    for (int index = 0; index < SessionSnapshot::SIZE * SessionSnapshot::SIZE; ++index) {
+        const int shift = (index % cellsPerByte) * bitsPerCell;
+        board[index / SessionSnapshot::SIZE][index % SessionSnapshot::SIZE] =
+            decodeCell(packed[index / cellsPerByte] >> shift);
+    }
+    return board;
+}
+
+bool isValidRecord(const Record& record) {
+    return record.magic == snapshotMagic and record.version == snapshotVersion and record.active == 1 and
+           record.sessionIdLength > 0 and record.sessionIdLength <= SessionSnapshot::maxSessionIdBytes;
+}
+}
+
+SessionSnapshot::SessionSnapshot(const QString& filePath)
+    : file(filePath) {
+}
+
+SessionSnapshot::~SessionSnapshot() {
+    unmap();
+}
+
+QString SessionSnapshot::defaultFilePath() {
+    const QString directory = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    QDir().mkpath(directory);
+    return QDir(directory).filePath(snapshotFileName);
+}
+
+std::optional<SessionSnapshot::State> SessionSnapshot::restore() {
+    Record record;
+    if (mappedData) {
+        std::memcpy(&record, mappedData, sizeof(Record));
+    } else {
+        QFile savedFile(file.fileName());
+        if (!savedFile.open(QIODevice::ReadOnly) or savedFile.size() != static_cast<qint64>(sizeof(Record)) or
+            savedFile.read(reinterpret_cast<char*>(&record), sizeof(Record)) != static_cast<qint64>(sizeof(Record))) {
+            return std::nullopt;
+        }
+    }
+    if (!isValidRecord(record)) {
+        return std::nullopt;
+    }
+    State state;
+    state.sessionId = QString::fromUtf8(record.sessionId, record.sessionIdLength);
+    state.openingBoard = unpackBoard(record.openingCells);
+    state.playerBoard = unpackBoard(record.playerCells);
+    state.opponentBoard = unpackBoard(record.opponentCells);
+    state.myTurn = record.myTurn != 0;
+    state.sequence = record.sequence;
+    return state;
+}
+
+bool SessionSnapshot::store(const State& state) {
+    const QByteArray sessionId = state.sessionId.toUtf8();
+    if (sessionId.isEmpty() or sessionId.size() > maxSessionIdBytes or !map(true)) {
+        clear();
+        return false;
+    }
+    auto* record = reinterpret_cast<Record*>(mappedData);
+    record->active = 0;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+
+    record->magic = snapshotMagic;
+    record->version = snapshotVersion;
+    record->sequence = state.sequence;
+    record->myTurn = state.myTurn ? 1 : 0;
+    record->sessionIdLength = static_cast<std::uint8_t>(sessionId.size());
+    std::memcpy(record->sessionId, sessionId.constData(), sessionId.size());
+    packBoard(record->openingCells, state.openingBoard);
+    packBoard(record->playerCells, state.playerBoard);
+    packBoard(record->opponentCells, state.opponentBoard);
+
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    record->active = 1;
+    return true;
+}
+
+void SessionSnapshot::setCell(GameHistory::Board board, int x, int y, char cell) {
+    if (!isActive() or x < 0 or x >= SIZE or y < 0 or y >= SIZE) {
+        return;
+    }
+    auto* record = reinterpret_cast<Record*>(mappedData);
+    packCell(board == GameHistory::Board::Player ? record->playerCells : record->opponentCells, x * SIZE + y, cell);
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    record->sequence++;
+}
+
+void SessionSnapshot::setMyTurn(bool myTurn) {
+    if (isActive()) {
+        reinterpret_cast<Record*>(mappedData)->myTurn = myTurn ? 1 : 0;
+    }
+}
+
+void SessionSnapshot::clear() {
+    if (map(false)) {
+        reinterpret_cast<Record*>(mappedData)->active = 0;
+    }
+}
+
+bool SessionSnapshot::isActive() const {
+    return mappedData and reinterpret_cast<const Record*>(mappedData)->active == 1;
+}
+
+std::uint64_t SessionSnapshot::sequence() const {
+    return isActive() ? reinterpret_cast<const Record*>(mappedData)->sequence : 0;
+}
+
+bool SessionSnapshot::map(bool create) {
+    if (mappedData) {
+        return true;
+    }
+    // Only the write path may create or resize the file; anything else leaves a foreign or
+    // outdated file exactly as it was found.
+    if (!create and (!file.exists() or file.size() != static_cast<qint64>(sizeof(Record)))) {
+        return false;
+    }
+    if (!file.open(QIODevice::ReadWrite)) {
+        return false;
+    }
+    if (file.size() != static_cast<qint64>(sizeof(Record)) and !file.resize(sizeof(Record))) {
+        file.close();
+        return false;
+    }
+    mappedData = file.map(0, sizeof(Record));
+    if (!mappedData) {
+        file.close();
+        return false;
+    }
+    return true;
+}
+
+void SessionSnapshot::unmap() {
+    if (mappedData) {
+        file.unmap(mappedData);
+        mappedData = nullptr;
+    }
+    if (file.isOpen()) {
+        file.close();
+    }
+}
@@ -0,0 +1,49 @@
+#ifndef SESSIONSNAPSHOT_H
+#define SESSIONSNAPSHOT_H
+
+#include <QFile>
+#include <QString>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "gamehistory.h"
+
+class SessionSnapshot {
+public:
+    static constexpr int SIZE = 10;
+    static constexpr int maxSessionIdBytes = 64;
+    using Cells = std::vector<std::vector<char>>;
+
+    struct State {
+        QString sessionId;
+        Cells openingBoard;
+        Cells playerBoard;
+        Cells opponentBoard;
+        bool myTurn = false;
+        std::uint64_t sequence = 0;
+    };
+
+    explicit SessionSnapshot(const QString& filePath);
+    ~SessionSnapshot();
+
+    static QString defaultFilePath();
+
+    std::optional<State> restore();
+    bool store(const State& state);
+    void setCell(GameHistory::Board board, int x, int y, char cell);
+    void setMyTurn(bool myTurn);
+    void clear();
+
+    bool isActive() const;
+    std::uint64_t sequence() const;
+
+private:
+    bool map(bool create);
+    void unmap();
+
+    QFile file;
+    uchar* mappedData = nullptr;
+};
+
+#endif
@@ -0,0 +1,269 @@
+#include "spectatorwall.h"
+
+#include <QPaintEvent>
+#include <QPainter>
+#include <QRegion>
+#include <QScrollBar>
+#include <algorithm>
+
+#include "boardcell.h"
+
+namespace {
+constexpr int miniCellSize = 6;
+constexpr int boardGap = 4;
+constexpr int tileMargin = 4;
+constexpr int boardPixels = miniCellSize * 10;
+constexpr int tileWidth = boardPixels * 2 + boardGap + tileMargin * 2;
+constexpr int tileHeight = boardPixels + tileMargin * 2;
+constexpr int playerBoardIndex = 0;
+constexpr int opponentBoardIndex = 1;
+}
+
+SpectatorWall::SpectatorWall(QWidget* parent)
+    : QAbstractScrollArea(parent)
+    , spriteAtlas(miniCellSize)
+    , frameScheduler(new FrameScheduler(this)) {
+    setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOn);
+    viewport()->setAttribute(Qt::WA_OpaquePaintEvent);
+    verticalScrollBar()->setSingleStep(tileHeight);
+    connect(frameScheduler, &FrameScheduler::frameDue, this, &SpectatorWall::flushFrame);
+}
+
+SpectatorWall::~SpectatorWall() = default;
+
+void SpectatorWall::addGame(const QString& gameId) {
+    if (gameIndexById.contains(gameId)) {
+        return;
+    }
+    SpectatedGame game;
+    game.id = gameId;
+    for (Cells& board : game.boards) {
+        board.fill(boardcell::empty);
+    }
+    gameIndexById.insert(gameId, static_cast<int>(games.size()));
+    games.push_back(std::move(game));
+
+    updateScrollRange();
+    fullRedrawPending = true;
+    frameScheduler->requestFrame();
+}
+
+void SpectatorWall::removeGame(const QString& gameId) {
+    const auto it = gameIndexById.constFind(gameId);
+    if (it == gameIndexById.cend()) {
+        return;
+    }
+    const int index = it.value();
+    clearDirtyCells();
+    gameIndexById.erase(it);
+    if (index != static_cast<int>(games.size()) - 1) {
+        games[index] = std::move(games.back());
+        gameIndexById[games[index].id] = index;
+    }
+    games.pop_back();
+
+    updateScrollRange();
+    fullRedrawPending = true;
+    frameScheduler->requestFrame();
+}
+
+void SpectatorWall::setPlayerBoard(const QString& gameId, const std::vector<std::vector<char>>& board) {
+    const auto it = gameIndexById.constFind(gameId);
+    if (it == gameIndexById.cend()) {
+        return;
+    }
+    const int index = it.value();
+    Cells& cells = games[index].boards[playerBoardIndex];
+    bool changed = false;
+    for (int i = 0; i < SIZE and i < static_cast<int>(board.size()); ++i) {
+        for (int j = 0; j < SIZE and j < static_cast<int>(board[i].size()); ++j) {
+            const int cellIndex = i * SIZE + j;
+            if (cells[cellIndex] != board[i][j]) {
+                cells[cellIndex] = board[i][j];
+                markDirty(index, playerBoardIndex, cellIndex);
+                changed = true;
+            }
+        }
+    }
+    if (!changed) {
+        return;
+    }
+    frameScheduler->requestFrame();
+}
+
+void SpectatorWall::updatePlayerBoard(const QString& gameId, int x, int y, const QString& result) {
+    setCell(gameId, playerBoardIndex, x, y, boardcell::fromShotResult(result));
+}
+
+void SpectatorWall::updateOpponentBoard(const QString& gameId, int x, int y, const QString& result) {
+    setCell(gameId, opponentBoardIndex, x, y, boardcell::fromShotResult(result));
+}
+
+char SpectatorWall::cellAt(const QString& gameId, bool opponentBoard, int x, int y) const {
+    const auto it = gameIndexById.constFind(gameId);
+    if (it == gameIndexById.cend() or x < 0 or x >= SIZE or y < 0 or y >= SIZE) {
+        return 0;
+    }
+    return games[it.value()].boards[opponentBoard ? opponentBoardIndex : playerBoardIndex][x * SIZE + y];
+}
+
+void SpectatorWall::setCell(const QString& gameId, int boardIndex, int x, int y, char cell) {
+    if (!cell or x < 0 or x >= SIZE or y < 0 or y >= SIZE) {
+        return;
+    }
+    const auto it = gameIndexById.constFind(gameId);
+    if (it == gameIndexById.cend()) {
+        return;
+    }
+    const int cellIndex = x * SIZE + y;
+    char& current = games[it.value()].boards[boardIndex][cellIndex];
+    if (current == cell) {
+        return;
+    }
+    current = cell;
+    markDirty(it.value(), boardIndex, cellIndex);
+    frameScheduler->requestFrame();
+}
+
+void SpectatorWall::markDirty(int gameIndex, int boardIndex, int cellIndex) {
+    std::array<CellMask, 2>& dirty = games[gameIndex].dirtyCells;
+    if (dirty[playerBoardIndex].none() and dirty[opponentBoardIndex].none()) {
+        dirtyGames.push_back(gameIndex);
+    }
+    dirty[boardIndex].set(cellIndex);
+}
+
+void SpectatorWall::clearDirtyCells() {
+    for (int gameIndex : dirtyGames) {
+        for (CellMask& dirty : games[gameIndex].dirtyCells) {
+            dirty.reset();
+        }
+    }
+    dirtyGames.clear();
+}
+
+void SpectatorWall::flushFrame() {
+    lastFrameSprites = 0;
+    if (backingSurface.isNull()) {
+        clearDirtyCells();
+        return;
+    }
+    if (fullRedrawPending) {
+        renderVisibleGames();
+        clearDirtyCells();
+        viewport()->update();
+        return;
+    }
+
+    const QRect visibleRect = backingSurface.rect();
+    QPainter painter(&backingSurface);
+    QRegion dirtyRegion;
+    for (int gameIndex : dirtyGames) {
+        for (int boardIndex = playerBoardIndex; boardIndex <= opponentBoardIndex; ++boardIndex) {
+            const CellMask& dirty = games[gameIndex].dirtyCells[boardIndex];
+            for (int cellIndex = 0; cellIndex < SIZE * SIZE; ++cellIndex) {
+                if (!dirty.test(cellIndex)) {
+                    continue;
+                }
+                const QRect target = cellRect(gameIndex, boardIndex, cellIndex);
+                if (!visibleRect.intersects(target)) {
+                    continue;
+                }
+                drawCell(painter, gameIndex, boardIndex, cellIndex);
+                dirtyRegion += target;
+            }
+        }
+    }
+    clearDirtyCells();
+
+    if (!dirtyRegion.isEmpty()) {
+        viewport()->update(dirtyRegion);
+    }
+}
+
+void SpectatorWall::renderVisibleGames() {
+    fullRedrawPending = false;
+    lastFrameSprites = 0;
+    backingSurface.fill(palette().color(QPalette::Window));
+
+    const QRect content = visibleContentRect();
+    const int columns = columnCount();
+    const int firstRow = content.top() / tileHeight;
+    const int lastRow = content.bottom() / tileHeight;
+    const int gamesTotal = static_cast<int>(games.size());
+
+    QPainter painter(&backingSurface);
+    for (int row = firstRow; row <= lastRow; ++row) {
+        for (int column = 0; column < columns; ++column) {
+            const int gameIndex = row * columns + column;
+            if (gameIndex >= gamesTotal) {
+                return;
+            }
+            for (int boardIndex = playerBoardIndex; boardIndex <= opponentBoardIndex; ++boardIndex) {
+                for (int cellIndex = 0; cellIndex < SIZE * SIZE; ++cellIndex) {
+                    drawCell(painter, gameIndex, boardIndex, cellIndex);
+                }
+            }
+        }
+    }
+}
+
+void SpectatorWall::drawCell(QPainter& painter, int gameIndex, int boardIndex, int cellIndex) {
+    const char cell = games[gameIndex].boards[boardIndex][cellIndex];
+    const auto sprite = CellSpriteAtlas::spriteFor(cell, boardIndex == opponentBoardIndex);
+    painter.drawImage(cellRect(gameIndex, boardIndex, cellIndex).topLeft(), spriteAtlas.image(),
+                      spriteAtlas.sourceRect(sprite));
+    ++lastFrameSprites;
+}
+
+void SpectatorWall::updateScrollRange() {
+    const int columns = columnCount();
+    const int rows = (static_cast<int>(games.size()) + columns - 1) / columns;
+    const int contentHeight = rows * tileHeight;
+    verticalScrollBar()->setPageStep(viewport()->height());
+    verticalScrollBar()->setRange(0, std::max(0, contentHeight - viewport()->height()));
+}
+
+QRect SpectatorWall::cellRect(int gameIndex, int boardIndex, int cellIndex) const {
+    const int columns = columnCount();
+    const int tileX = (gameIndex % columns) * tileWidth + tileMargin;
+    const int tileY = (gameIndex / columns) * tileHeight + tileMargin - verticalScrollBar()->value();
+    const int boardX = tileX + boardIndex * (boardPixels + boardGap);
+    const int row = cellIndex / SIZE;
+    const int column = cellIndex % SIZE;
+    return {boardX + column * miniCellSize, tileY + row * miniCellSize, miniCellSize, miniCellSize};
+}
+
+QRect SpectatorWall::visibleContentRect() const {
+    return viewport()->rect().translated(0, verticalScrollBar()->value());
+}
+
+int SpectatorWall::columnCount() const {
+    return std::max(1, viewport()->width() / tileWidth);
+}
+
+void SpectatorWall::paintEvent(QPaintEvent* event) {
+    if (backingSurface.isNull()) {
+        return;
+    }
+    if (fullRedrawPending) {
+        renderVisibleGames();
+        clearDirtyCells();
+    }
+    QPainter painter(viewport());
+    painter.drawImage(event->rect(), backingSurface, event->rect());
+}
+
+void SpectatorWall::resizeEvent(QResizeEvent* event) {
+    QAbstractScrollArea::resizeEvent(event);
+    backingSurface = QImage(viewport()->size(), QImage::Format_ARGB32_Premultiplied);
+    updateScrollRange();
+    fullRedrawPending = true;
+    flushFrame();
+}
+
+void SpectatorWall::scrollContentsBy(int, int) {
+    fullRedrawPending = true;
+    flushFrame();
+}
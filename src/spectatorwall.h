@@ -0,0 +1,69 @@
+#ifndef SPECTATORWALL_H
+#define SPECTATORWALL_H
+
+#include <QAbstractScrollArea>
+#include <QHash>
+#include <QImage>
+#include <QString>
+#include <array>
+#include <bitset>
+#include <vector>
+
+#include "cellspriteatlas.h"
+#include "framescheduler.h"
+
+class SpectatorWall : public QAbstractScrollArea {
+    Q_OBJECT
+
+public:
+    explicit SpectatorWall(QWidget* parent = nullptr);
+    ~SpectatorWall() override;
+
+    void addGame(const QString& gameId);
+    void removeGame(const QString& gameId);
+    void setPlayerBoard(const QString& gameId, const std::vector<std::vector<char>>& board);
+    void updatePlayerBoard(const QString& gameId, int x, int y, const QString& result);
+    void updateOpponentBoard(const QString& gameId, int x, int y, const QString& result);
+
+    int gameCount() const { return static_cast<int>(games.size()); }
+    char cellAt(const QString& gameId, bool opponentBoard, int x, int y) const;
+    int lastFrameSpriteCount() const { return lastFrameSprites; }
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void resizeEvent(QResizeEvent* event) override;
+    void scrollContentsBy(int dx, int dy) override;
+
+private:
+    static constexpr int SIZE = 10;
+    using Cells = std::array<char, SIZE * SIZE>;
+    using CellMask = std::bitset<SIZE * SIZE>;
+
+    struct SpectatedGame {
+        QString id;
+        std::array<Cells, 2> boards;
+        std::array<CellMask, 2> dirtyCells;
+    };
+
+    void markDirty(int gameIndex, int boardIndex, int cellIndex);
+    void clearDirtyCells();
+    void setCell(const QString& gameId, int boardIndex, int x, int y, char cell);
+    void flushFrame();
+    void renderVisibleGames();
+    void drawCell(QPainter& painter, int gameIndex, int boardIndex, int cellIndex);
+    void updateScrollRange();
+    QRect cellRect(int gameIndex, int boardIndex, int cellIndex) const;
+    QRect visibleContentRect() const;
+    int columnCount() const;
+
+    CellSpriteAtlas spriteAtlas;
+    std::vector<SpectatedGame> games;
+    QHash<QString, int> gameIndexById;
+    std::vector<int> dirtyGames;
+    bool fullRedrawPending = true;
+    QImage backingSurface;
+    FrameScheduler* frameScheduler = nullptr;
+    int lastFrameSprites = 0;
+};
+
+#endif
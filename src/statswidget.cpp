@@ -0,0 +1,67 @@
+#include "statswidget.h"
+
+#include <QHBoxLayout>
+#include <QPainter>
+#include <QVBoxLayout>
+#include <algorithm>
+
+namespace {
+constexpr int heatmapCellSize = 20;
+constexpr int heatmapSide = 10;
+constexpr int heatmapPixels = heatmapCellSize * heatmapSide;
+constexpr int heatmapGap = 20;
+constexpr int heatmapMargin = 10;
+constexpr auto statsWindowTitle = "Статистика";
+constexpr auto firstShotHeatmapLabel = "Первые выстрелы";
+constexpr auto opponentShotHeatmapLabel = "Выстрелы противников";
+}
+
+StatsWidget::StatsWidget(const HistoryStore::Statistics& statistics, QWidget* parent)
+    : QWidget(parent)
+    , gameStatistics(statistics)
+    , summaryLabel(new QLabel(this))
+    , firstShotLabel(new QLabel(tr(firstShotHeatmapLabel), this))
+    , opponentShotLabel(new QLabel(tr(opponentShotHeatmapLabel), this)) {
+    setWindowTitle(tr(statsWindowTitle));
+
+    summaryLabel->setText(tr("Игр: %1\nПобед: %2%\nСредне выстрелов до победы: %3")
+                                  .arg(gameStatistics.games)
+                                  .arg(gameStatistics.winRate() * 100.0, 0, 'f', 1)
+                                  .arg(gameStatistics.averageShotsToWin(), 0, 'f', 1));
+
+    auto* labelsLayout = new QHBoxLayout;
+    firstShotLabel->setFixedWidth(heatmapPixels + heatmapGap);
+    labelsLayout->addWidget(firstShotLabel);
+    labelsLayout->addWidget(opponentShotLabel);
+
+    auto* layout = new QVBoxLayout(this);
+    layout->addWidget(summaryLabel);
+    layout->addLayout(labelsLayout);
+    layout->addSpacing(heatmapPixels + heatmapMargin);
+    setMinimumWidth(heatmapPixels * 2 + heatmapGap + heatmapMargin * 2);
+}
+
+StatsWidget::~StatsWidget() = default;
+
+void StatsWidget::paintEvent(QPaintEvent*) {
+    QPainter painter(this);
+    const int top = height() - heatmapPixels - heatmapMargin;
+    drawHeatmap(painter, gameStatistics.firstShotHeatmap, QPoint(heatmapMargin, top));
+    drawHeatmap(painter, gameStatistics.opponentShotHeatmap,
+                QPoint(heatmapMargin + heatmapPixels + heatmapGap, top));
+}
+
+void StatsWidget::drawHeatmap(QPainter& painter, const HistoryStore::Heatmap& heatmap, QPoint origin) {
+    const std::uint32_t peak = std::max<std::uint32_t>(1, *std::max_element(heatmap.begin(), heatmap.end()));
+    for (int i = 0; i < heatmapSide; ++i) {
+        for (int j = 0; j < heatmapSide; ++j) {
+            const std::uint32_t value = heatmap[i * heatmapSide + j];
+            const int intensity = static_cast<int>(255 * value / peak);
+            const QRect cell(origin + QPoint(j * heatmapCellSize, i * heatmapCellSize),
+                             QSize(heatmapCellSize, heatmapCellSize));
+            painter.fillRect(cell, QColor(255, 255 - intensity, 255 - intensity));
+            painter.setPen(Qt::black);
+            painter.drawRect(cell.adjusted(0, 0, -1, -1));
+        }
+    }
+}
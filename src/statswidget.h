@@ -0,0 +1,28 @@
+#ifndef STATSWIDGET_H
+#define STATSWIDGET_H
+
+#include <QLabel>
+#include <QWidget>
+
+#include "historystore.h"
+
+class StatsWidget : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit StatsWidget(const HistoryStore::Statistics& statistics, QWidget* parent = nullptr);
+    ~StatsWidget() override;
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+
+private:
+    void drawHeatmap(QPainter& painter, const HistoryStore::Heatmap& heatmap, QPoint origin);
+
+    HistoryStore::Statistics gameStatistics;
+    QLabel* summaryLabel = nullptr;
+    QLabel* firstShotLabel = nullptr;
+    QLabel* opponentShotLabel = nullptr;
+};
+
+#endif
@@ -0,0 +1,74 @@
+#include "timelinescrubber.h"
+
+#include <QPainter>
+#include <QVBoxLayout>
+#include <algorithm>
+
+namespace {
+constexpr int previewCellSize = 20;
+constexpr int previewBoardGap = 20;
+constexpr int previewMargin = 10;
+constexpr int previewBoardPixels = previewCellSize * GameHistory::SIZE;
+constexpr auto reviewWindowTitle = "Просмотр партии";
+}
+
+TimelineScrubber::TimelineScrubber(const GameHistory& history, QWidget* parent)
+    : QWidget(parent)
+    , gameHistory(history)
+    , position(history.positionAt(history.eventCount()))
+    , shownEventIndex(history.eventCount())
+    , spriteAtlas(previewCellSize)
+    , timelineSlider(new QSlider(Qt::Horizontal, this))
+    , turnLabel(new QLabel(this)) {
+    setWindowTitle(tr(reviewWindowTitle));
+
+    auto* layout = new QVBoxLayout(this);
+    layout->addSpacing(previewBoardPixels + previewMargin * 2);
+    layout->addWidget(timelineSlider);
+    layout->addWidget(turnLabel);
+    setMinimumWidth(previewBoardPixels * 2 + previewBoardGap + previewMargin * 2);
+
+    timelineSlider->setRange(0, gameHistory.eventCount());
+    timelineSlider->setValue(shownEventIndex);
+    connect(timelineSlider, &QSlider::valueChanged, this, &TimelineScrubber::onSliderMoved);
+
+    setEventIndex(shownEventIndex);
+}
+
+TimelineScrubber::~TimelineScrubber() = default;
+
+void TimelineScrubber::setEventIndex(int eventIndex) {
+    eventIndex = std::clamp(eventIndex, 0, gameHistory.eventCount());
+    if (eventIndex != shownEventIndex) {
+        position = gameHistory.positionAt(eventIndex);
+    }
+    shownEventIndex = eventIndex;
+
+    if (timelineSlider->value() != eventIndex) {
+        timelineSlider->setValue(eventIndex);
+    }
+    turnLabel->setText(tr("Ход %1 из %2").arg(eventIndex).arg(gameHistory.eventCount()));
+    update();
+}
+
+void TimelineScrubber::onSliderMoved(int value) {
+    setEventIndex(value);
+}
+
+void TimelineScrubber::paintEvent(QPaintEvent*) {
+    QPainter painter(this);
+    drawBoard(painter, position.player, QPoint(previewMargin, previewMargin), false);
+    drawBoard(painter, position.opponent,
+              QPoint(previewMargin + previewBoardPixels + previewBoardGap, previewMargin), true);
+}
+
+void TimelineScrubber::drawBoard(QPainter& painter, const GameHistory::Cells& cells, QPoint origin,
+                                 bool opponentBoard) {
+    for (int i = 0; i < GameHistory::SIZE; ++i) {
+        for (int j = 0; j < GameHistory::SIZE; ++j) {
+            const auto sprite = CellSpriteAtlas::spriteFor(cells[i * GameHistory::SIZE + j], opponentBoard);
+            painter.drawImage(origin + QPoint(j * previewCellSize, i * previewCellSize), spriteAtlas.image(),
+                              spriteAtlas.sourceRect(sprite));
+        }
+    }
+}
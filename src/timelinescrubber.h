@@ -0,0 +1,37 @@
+#ifndef TIMELINESCRUBBER_H
+#define TIMELINESCRUBBER_H
+
+#include <QLabel>
+#include <QSlider>
+#include <QWidget>
+
+#include "cellspriteatlas.h"
+#include "gamehistory.h"
+
+class TimelineScrubber : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit TimelineScrubber(const GameHistory& history, QWidget* parent = nullptr);
+    ~TimelineScrubber() override;
+
+    void setEventIndex(int eventIndex);
+    int eventIndex() const { return shownEventIndex; }
+    const GameHistory::Position& shownPosition() const { return position; }
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+
+private:
+    void onSliderMoved(int value);
+    void drawBoard(QPainter& painter, const GameHistory::Cells& cells, QPoint origin, bool opponentBoard);
+
+    GameHistory gameHistory;
+    GameHistory::Position position;
+    int shownEventIndex = 0;
+    CellSpriteAtlas spriteAtlas;
+    QSlider* timelineSlider = nullptr;
+    QLabel* turnLabel = nullptr;
+};
+
+#endif
@@ -0,0 +1,44 @@
+#include "transport.h"
+
+#include <QDebug>
+
+#include "directtransport.h"
+#include "localsockettransport.h"
+#include "websockettransport.h"
+
+namespace {
+constexpr auto localScheme = "local";
+constexpr auto directScheme = "direct";
+constexpr auto webSocketScheme = "ws";
+constexpr auto secureWebSocketScheme = "wss";
+}
+
+Transport::Transport(QObject* parent)
+    : QObject(parent) {
+}
+
+Transport::~Transport() = default;
+
+QUrl Transport::urlFromString(const QString& text) {
+    // QUrl lowercases the host, but local socket names are case-sensitive, so "local://Name"
+    // is carried in the path like "local:Name".
+    const QString localAuthority = QString(localScheme) + "://";
+    if (text.startsWith(localAuthority, Qt::CaseInsensitive) and !text.mid(localAuthority.size()).startsWith(u'/')) {
+        return QUrl(QString(localScheme) + u':' + text.mid(localAuthority.size()));
+    }
+    return QUrl(text);
+}
+
+Transport* Transport::create(const QUrl& url, QObject* parent) {
+    if (url.scheme() == localScheme) {
+        return new LocalSocketTransport(parent);
+    }
+    if (url.scheme() == directScheme) {
+        return new DirectTransport(parent);
+    }
+    if (url.scheme() == webSocketScheme or url.scheme() == secureWebSocketScheme) {
+        return new WebSocketTransport(parent);
+    }
+    qWarning("Unknown transport scheme \"%s\", falling back to WebSocket", qPrintable(url.scheme()));
+    return new WebSocketTransport(parent);
+}
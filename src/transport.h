@@ -0,0 +1,29 @@
+#ifndef TRANSPORT_H
+#define TRANSPORT_H
+
+#include <QObject>
+#include <QString>
+#include <QUrl>
+
+class Transport : public QObject {
+    Q_OBJECT
+
+public:
+    explicit Transport(QObject* parent = nullptr);
+    ~Transport() override;
+
+    static Transport* create(const QUrl& url, QObject* parent = nullptr);
+    static QUrl urlFromString(const QString& text);
+
+    virtual void open(const QUrl& url) = 0;
+    virtual void close() = 0;
+    virtual bool isConnected() const = 0;
+    virtual qint64 sendTextMessage(const QString& message) = 0;
+
+    signals:
+        void connected();
+    void disconnected();
+    void textMessageReceived(const QString& message);
+};
+
+#endif
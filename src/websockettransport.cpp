@@ -0,0 +1,34 @@
+#include "websockettransport.h"
+
+WebSocketTransport::WebSocketTransport(QObject* parent)
+    : WebSocketTransport(new QWebSocket(QString(), QWebSocketProtocol::VersionLatest), parent) {
+}
+
+WebSocketTransport::WebSocketTransport(QWebSocket* socket, QObject* parent)
+    : Transport(parent)
+    , webSocket(socket) {
+    webSocket->setParent(this);
+    connect(webSocket, &QWebSocket::connected, this, &Transport::connected);
+    connect(webSocket, &QWebSocket::disconnected, this, &Transport::disconnected);
+    connect(webSocket, &QWebSocket::textMessageReceived, this, &Transport::textMessageReceived);
+}
+
+WebSocketTransport::~WebSocketTransport() = default;
+
+void WebSocketTransport::open(const QUrl& url) {
+    webSocket->open(url);
+}
+
+void WebSocketTransport::close() {
+    if (webSocket->state() != QAbstractSocket::UnconnectedState) {
+        webSocket->close();
+    }
+}
+
+bool WebSocketTransport::isConnected() const {
+    return webSocket->state() == QAbstractSocket::ConnectedState;
+}
+
+qint64 WebSocketTransport::sendTextMessage(const QString& message) {
+    return webSocket->sendTextMessage(message);
+}
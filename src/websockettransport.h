@@ -0,0 +1,25 @@
+#ifndef WEBSOCKETTRANSPORT_H
+#define WEBSOCKETTRANSPORT_H
+
+#include <QWebSocket>
+
+#include "transport.h"
+
+class WebSocketTransport : public Transport {
+    Q_OBJECT
+
+public:
+    explicit WebSocketTransport(QObject* parent = nullptr);
+    explicit WebSocketTransport(QWebSocket* socket, QObject* parent = nullptr);
+    ~WebSocketTransport() override;
+
+    void open(const QUrl& url) override;
+    void close() override;
+    bool isConnected() const override;
+    qint64 sendTextMessage(const QString& message) override;
+
+private:
+    QWebSocket* webSocket = nullptr;
+};
+
+#endif
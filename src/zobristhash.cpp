@@ -0,0 +1,59 @@
+#include "zobristhash.h"
+
+#include <array>
+
+#include "boardcell.h"
+
+namespace {
+constexpr int boardSide = 10;
+constexpr int cellCount = boardSide * boardSide;
+constexpr int statesPerCell = 4;
+constexpr int keysPerBoard = cellCount * statesPerCell;
+
+constexpr std::uint64_t splitmix64(std::uint64_t value) {
+    value += 0x9e3779b97f4a7c15ULL;
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+}
+
+constexpr std::array<std::uint64_t, keysPerBoard * 2> makeKeys() {
+    std::array<std::uint64_t, keysPerBoard * 2> keys{};
+    for (int i = 0; i < keysPerBoard * 2; ++i) {
+        keys[i] = i % statesPerCell == 0 ? 0 : splitmix64(static_cast<std::uint64_t>(i));
+    }
+    return keys;
+}
+
+constexpr auto zobristKeys = makeKeys();
+
+int stateOf(char cell) {
+    switch (cell) {
+        case boardcell::ship:
+            return 1;
+        case boardcell::miss:
+            return 2;
+        case boardcell::hit:
+            return 3;
+        default:
+            return 0;
+    }
+}
+}
+
+std::uint64_t zobrist::cellKey(Board board, int cellIndex, char cell) {
+    if (cellIndex < 0 or cellIndex >= cellCount) {
+        return 0;
+    }
+    return zobristKeys[static_cast<int>(board) * keysPerBoard + cellIndex * statesPerCell + stateOf(cell)];
+}
+
+std::uint64_t zobrist::boardHash(Board board, const std::vector<std::vector<char>>& cells) {
+    std::uint64_t hash = 0;
+    for (int i = 0; i < boardSide and i < static_cast<int>(cells.size()); ++i) {
+        for (int j = 0; j < boardSide and j < static_cast<int>(cells[i].size()); ++j) {
+            hash ^= cellKey(board, i * boardSide + j, cells[i][j]);
+        }
+    }
+    return hash;
+}
@@ -0,0 +1,18 @@
+#ifndef ZOBRISTHASH_H
+#define ZOBRISTHASH_H
+
+#include <cstdint>
+#include <vector>
+
+// Keys are derived, not random, so the server can reproduce them:
+// key = splitmix64(board * 400 + cellIndex * 4 + state), with board 0 for the
+// player's own board and 1 for the opponent board, and state 1 = ship,
+// 2 = miss, 3 = hit. Empty cells contribute no key.
+namespace zobrist {
+enum class Board : std::uint8_t { Player, Opponent };
+
+std::uint64_t cellKey(Board board, int cellIndex, char cell);
+std::uint64_t boardHash(Board board, const std::vector<std::vector<char>>& cells);
+}
+
+#endif
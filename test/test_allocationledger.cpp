@@ -0,0 +1,80 @@
+#include <QtTest/QtTest>
+#include <vector>
+
+#include "../src/allocationledger.h"
+
+class TestAllocationLedger : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testRecordsPerMessageType();
+    void testShotCycleAverage();
+    void testScopeCountsMessages();
+    void testReport();
+};
+
+void TestAllocationLedger::testRecordsPerMessageType() {
+    AllocationLedger ledger;
+    ledger.record(AllocationLedger::MessageType::Board, {12, 4096});
+    ledger.record(AllocationLedger::MessageType::ShotResult, {2, 64});
+    ledger.record(AllocationLedger::MessageType::ShotResult, {0, 0});
+
+    const AllocationLedger::Entry& shots = ledger.entry(AllocationLedger::MessageType::ShotResult);
+    QCOMPARE(shots.messages, quint64(2));
+    QCOMPARE(shots.allocations, quint64(2));
+    QCOMPARE(shots.bytes, quint64(64));
+
+    const AllocationLedger::Entry total = ledger.gameTotal();
+    QCOMPARE(total.messages, quint64(3));
+    QCOMPARE(total.allocations, quint64(14));
+    QCOMPARE(total.bytes, quint64(4160));
+
+    ledger.reset();
+    QCOMPARE(ledger.gameTotal().messages, quint64(0));
+}
+
+void TestAllocationLedger::testShotCycleAverage() {
+    AllocationLedger ledger;
+    QCOMPARE(ledger.allocationsPerShotCycle(), 0.0);
+
+    ledger.record(AllocationLedger::MessageType::Board, {100, 0});
+    for (int i = 0; i < 4; ++i) {
+        ledger.record(AllocationLedger::MessageType::Shoot, {1, 16});
+        ledger.record(AllocationLedger::MessageType::ShotResult, {0, 0});
+        ledger.record(AllocationLedger::MessageType::OpponentShot, {1, 16});
+    }
+    QCOMPARE(ledger.allocationsPerShotCycle(), 2.0);
+}
+
+void TestAllocationLedger::testScopeCountsMessages() {
+    AllocationLedger ledger;
+    {
+        const AllocationLedger::Scope scope(ledger, AllocationLedger::MessageType::Turn);
+        auto* buffer = new std::vector<int>(64);
+        delete buffer;
+    }
+    const AllocationLedger::Entry& turn = ledger.entry(AllocationLedger::MessageType::Turn);
+    QCOMPARE(turn.messages, quint64(1));
+    if (allocationcounter::isEnabled()) {
+        QVERIFY(turn.allocations >= 2);
+        QVERIFY(turn.bytes >= 64 * sizeof(int));
+    } else {
+        QCOMPARE(turn.allocations, quint64(0));
+    }
+}
+
+void TestAllocationLedger::testReport() {
+    AllocationLedger ledger;
+    ledger.record(AllocationLedger::MessageType::Shoot, {3, 96});
+    ledger.record(AllocationLedger::MessageType::OpponentShot, {1, 32});
+
+    const QString report = ledger.report();
+    QVERIFY(report.startsWith("Allocations this game: 4 (128 bytes) over 2 messages"));
+    QVERIFY(report.contains("shoot: 1 messages, 3 allocations, 96 bytes"));
+    QVERIFY(report.contains("opponent shot: 1 messages"));
+    QVERIFY(!report.contains("lobby"));
+    QVERIFY(report.contains("not allocation-free"));
+}
+
+QTEST_MAIN(TestAllocationLedger)
+#include "test_allocationledger.moc"
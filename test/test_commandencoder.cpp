@@ -0,0 +1,36 @@
+#include <QtTest/QtTest>
+
+#include "../src/commandencoder.h"
+
+class TestCommandEncoder : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testShootCommands();
+    void testCommandsAreShared();
+    void testOutOfRange();
+};
+
+void TestCommandEncoder::testShootCommands() {
+    const CommandEncoder encoder;
+    for (int x = 0; x < CommandEncoder::SIZE; ++x) {
+        for (int y = 0; y < CommandEncoder::SIZE; ++y) {
+            QCOMPARE(encoder.shoot(x, y), QString("shoot %1 %2").arg(x).arg(y));
+        }
+    }
+}
+
+void TestCommandEncoder::testCommandsAreShared() {
+    const CommandEncoder encoder;
+    QCOMPARE(encoder.shoot(3, 7).constData(), encoder.shoot(3, 7).constData());
+    QCOMPARE(&encoder.shoot(3, 7), &encoder.shoot(3, 7));
+}
+
+void TestCommandEncoder::testOutOfRange() {
+    const CommandEncoder encoder;
+    QVERIFY(encoder.shoot(-1, 0).isEmpty());
+    QVERIFY(encoder.shoot(0, CommandEncoder::SIZE).isEmpty());
+}
+
+QTEST_MAIN(TestCommandEncoder)
+#include "test_commandencoder.moc"
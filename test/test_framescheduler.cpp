@@ -0,0 +1,63 @@
+#include <QtTest/QtTest>
+
+#include "../src/framescheduler.h"
+
+class TestFrameScheduler : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testRequestsAreCoalesced();
+    void testFirstFrameLatencyIsBounded();
+    void testFlush();
+
+private:
+    static constexpr int frameIntervalMs = 20;
+};
+
+void TestFrameScheduler::testRequestsAreCoalesced() {
+    FrameScheduler scheduler(nullptr, frameIntervalMs);
+    QSignalSpy spy(&scheduler, &FrameScheduler::frameDue);
+
+    for (int i = 0; i < 100; ++i) {
+        scheduler.requestFrame();
+    }
+    QVERIFY(scheduler.isFramePending());
+    QTRY_COMPARE(spy.count(), 1);
+    QTest::qWait(frameIntervalMs * 3);
+    QCOMPARE(spy.count(), 1);
+    QVERIFY(!scheduler.isFramePending());
+}
+
+void TestFrameScheduler::testFirstFrameLatencyIsBounded() {
+    FrameScheduler scheduler(nullptr, frameIntervalMs);
+    QSignalSpy spy(&scheduler, &FrameScheduler::frameDue);
+    QElapsedTimer elapsed;
+    elapsed.start();
+
+    scheduler.requestFrame();
+    while (spy.isEmpty() and elapsed.elapsed() < frameIntervalMs * 10) {
+        QTest::qWait(1);
+        scheduler.requestFrame();
+    }
+    QCOMPARE(spy.count(), 1);
+    QVERIFY(elapsed.elapsed() < frameIntervalMs * 5);
+}
+
+void TestFrameScheduler::testFlush() {
+    FrameScheduler scheduler(nullptr, frameIntervalMs);
+    QSignalSpy spy(&scheduler, &FrameScheduler::frameDue);
+    QSignalSpy finished(&scheduler, &FrameScheduler::frameFinished);
+
+    scheduler.flush();
+    QCOMPARE(spy.count(), 0);
+
+    scheduler.requestFrame();
+    scheduler.flush();
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(finished.count(), 1);
+    QVERIFY(finished.at(0).at(0).toLongLong() >= 0);
+    QVERIFY(!scheduler.isFramePending());
+}
+
+QTEST_MAIN(TestFrameScheduler)
+#include "test_framescheduler.moc"
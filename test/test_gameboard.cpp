@@ -1,4 +1,5 @@
 #include <QtTest/QtTest>
+#include <QVBoxLayout>
 
 #include "../src/gameboard.h"
 
@@ -16,6 +17,13 @@ private slots:
     void testUpdateOpponentBoard();
     void testCellClickedSignal();
     void testReset();
+    void testHistoryRecordsShots();
+    void testUpdatesAreDeferredToFrame();
+    void testBoardHashTracksUpdates();
+    void testResyncRestoresBoards();
+    void testResyncKeepsOpponentBoardWhenMissing();
+    void testWidgetsAreReusedAcrossGames();
+    void testRestoreBoards();
 
 private:
     GameBoard* gameBoard_ = nullptr;
@@ -88,6 +96,7 @@ void TestGameBoard::testOpponentBoardDisplay() {
 
 void TestGameBoard::testSetOpponentBoardInteractive() {
     gameBoard_->setOpponentBoardClickOrNot(true);
+    gameBoard_->flushPendingUpdates();
 
     QGridLayout* opponentLayout = qobject_cast<QGridLayout*>(gameBoard_->getOpponentWidget()->layout());
     QLayoutItem* item = opponentLayout->itemAtPosition(0, 0);
@@ -98,6 +107,7 @@ void TestGameBoard::testSetOpponentBoardInteractive() {
     QVERIFY(cell->isEnabled());
 
     gameBoard_->setOpponentBoardClickOrNot(false);
+    gameBoard_->flushPendingUpdates();
     QCOMPARE(cell->styleSheet(), QString(opponentDefaultStyle));
     QVERIFY(!cell->isEnabled());
 }
@@ -106,6 +116,7 @@ void TestGameBoard::testUpdatePlayerBoard() {
     gameBoard_->parseAndSaveBoard("Your board:\n..........\n..........\n..........\n..........\n..........\n..........\n..........\n..........\n..........\n..........");
 
     gameBoard_->updatePlayerBoard(0, 0, "miss");
+    gameBoard_->flushPendingUpdates();
     QGridLayout* playerLayout = qobject_cast<QGridLayout*>(gameBoard_->getPlayerWidget()->layout());
     QLayoutItem* item = playerLayout->itemAtPosition(0, 0);
     QVERIFY(item != nullptr);
@@ -114,6 +125,7 @@ void TestGameBoard::testUpdatePlayerBoard() {
     QCOMPARE(cell->styleSheet(), QString(missStyle));
 
     gameBoard_->updatePlayerBoard(1, 1, "hit");
+    gameBoard_->flushPendingUpdates();
     item = playerLayout->itemAtPosition(1, 1);
     QVERIFY(item != nullptr);
     cell = qobject_cast<QPushButton*>(item->widget());
@@ -123,6 +135,7 @@ void TestGameBoard::testUpdatePlayerBoard() {
 
 void TestGameBoard::testUpdateOpponentBoard() {
     gameBoard_->updateOpponentBoard(0, 0, "miss");
+    gameBoard_->flushPendingUpdates();
     QGridLayout* opponentLayout = qobject_cast<QGridLayout*>(gameBoard_->getOpponentWidget()->layout());
     QLayoutItem* item = opponentLayout->itemAtPosition(0, 0);
     QVERIFY(item != nullptr);
@@ -132,6 +145,7 @@ void TestGameBoard::testUpdateOpponentBoard() {
     QVERIFY(!cell->isEnabled());
 
     gameBoard_->updateOpponentBoard(1, 1, "kill");
+    gameBoard_->flushPendingUpdates();
     item = opponentLayout->itemAtPosition(1, 1);
     QVERIFY(item != nullptr);
     cell = qobject_cast<QPushButton*>(item->widget());
@@ -142,6 +156,7 @@ void TestGameBoard::testUpdateOpponentBoard() {
 
 void TestGameBoard::testCellClickedSignal() {
     gameBoard_->setOpponentBoardClickOrNot(true);
+    gameBoard_->flushPendingUpdates();
 
     QSignalSpy spy(gameBoard_, &GameBoard::cellClicked);
     QGridLayout* opponentLayout = qobject_cast<QGridLayout*>(gameBoard_->getOpponentWidget()->layout());
@@ -173,5 +188,161 @@ void TestGameBoard::testReset() {
     QCOMPARE(cell->styleSheet(), QString(playerEmptyStyle));
 }
 
+void TestGameBoard::testHistoryRecordsShots() {
+    gameBoard_->parseAndSaveBoard("Your board:\nS.........\n..........\n..........\n..........\n..........\n..........\n..........\n..........\n..........\n..........");
+    QVERIFY(gameBoard_->history().isEmpty());
+
+    gameBoard_->updateOpponentBoard(2, 3, "miss");
+    gameBoard_->updatePlayerBoard(0, 0, "kill");
+    gameBoard_->updatePlayerBoard(0, 1, "unknown");
+    QCOMPARE(gameBoard_->history().eventCount(), 2);
+    QCOMPARE(gameBoard_->opponentBoardSecond[2][3], 'o');
+    QCOMPARE(gameBoard_->playerBoardFirst[0][0], 'X');
+
+    const GameHistory::Position start = gameBoard_->history().positionAt(0);
+    QCOMPARE(start.player[0], 'S');
+    QCOMPARE(start.opponent[23], '.');
+
+    gameBoard_->cleanFiledForNewGame();
+    QCOMPARE(gameBoard_->history().eventCount(), 2);
+}
+
+void TestGameBoard::testUpdatesAreDeferredToFrame() {
+    gameBoard_->parseAndSaveBoard("Your board:\n..........\n..........\n..........\n..........\n..........\n..........\n..........\n..........\n..........\n..........");
+
+    QGridLayout* opponentLayout = qobject_cast<QGridLayout*>(gameBoard_->getOpponentWidget()->layout());
+    QPushButton* cell = qobject_cast<QPushButton*>(opponentLayout->itemAtPosition(4, 4)->widget());
+    QVERIFY(cell != nullptr);
+
+    gameBoard_->setOpponentBoardClickOrNot(true);
+    gameBoard_->updateOpponentBoard(4, 4, "hit");
+    gameBoard_->setOpponentBoardClickOrNot(false);
+    QCOMPARE(cell->styleSheet(), QString(opponentDefaultStyle));
+    QCOMPARE(gameBoard_->opponentBoardSecond[4][4], 'X');
+
+    QTRY_COMPARE(cell->styleSheet(), QString(hitStyle));
+    QVERIFY(!cell->isEnabled());
+}
+
+void TestGameBoard::testBoardHashTracksUpdates() {
+    gameBoard_->cleanFiledForNewGame();
+    QCOMPARE(gameBoard_->boardHash(), quint64(0));
+
+    gameBoard_->parseAndSaveBoard("Your board:\nSS........\n..........\n..........\n..........\n..........\n..........\n..........\n..........\n..........\n..........");
+    const quint64 initialHash = gameBoard_->boardHash();
+    QVERIFY(initialHash != 0);
+
+    gameBoard_->updatePlayerBoard(0, 0, "hit");
+    gameBoard_->updatePlayerBoard(5, 5, "miss");
+    gameBoard_->updateOpponentBoard(1, 2, "kill");
+    QVERIFY(gameBoard_->boardHash() != initialHash);
+    QCOMPARE(gameBoard_->boardHash(),
+             zobrist::boardHash(zobrist::Board::Player, gameBoard_->playerBoardFirst) ^
+                 zobrist::boardHash(zobrist::Board::Opponent, gameBoard_->opponentBoardSecond));
+
+    gameBoard_->updatePlayerBoard(0, 0, "hit");
+    QCOMPARE(gameBoard_->boardHash(),
+             zobrist::boardHash(zobrist::Board::Player, gameBoard_->playerBoardFirst) ^
+                 zobrist::boardHash(zobrist::Board::Opponent, gameBoard_->opponentBoardSecond));
+}
+
+void TestGameBoard::testResyncRestoresBoards() {
+    gameBoard_->parseAndSaveBoard("Your board:\nS.........\n..........\n..........\n..........\n..........\n..........\n..........\n..........\n..........\n..........");
+    gameBoard_->updatePlayerBoard(0, 0, "hit");
+    gameBoard_->updateOpponentBoard(3, 3, "miss");
+    const quint64 expectedHash = gameBoard_->boardHash();
+
+    gameBoard_->updateOpponentBoard(7, 7, "hit");
+    QVERIFY(gameBoard_->boardHash() != expectedHash);
+
+    gameBoard_->resyncBoards("Your board:\nX.........\n..........\n..........\n..........\n..........\n..........\n..........\n..........\n..........\n..........\n"
+                             "Opponent board:\n..........\n..........\n..........\n...o......\n..........\n..........\n..........\n..........\n..........\n..........");
+    QCOMPARE(gameBoard_->boardHash(), expectedHash);
+    QCOMPARE(gameBoard_->opponentBoardSecond[7][7], '.');
+    QCOMPARE(gameBoard_->history().eventCount(), 4);
+    QCOMPARE(gameBoard_->history().eventAt(3).board, GameHistory::Board::Opponent);
+    QCOMPARE(int(gameBoard_->history().eventAt(3).cellIndex), 77);
+    QCOMPARE(gameBoard_->history().positionAt(4).opponent[77], '.');
+
+    QGridLayout* opponentLayout = qobject_cast<QGridLayout*>(gameBoard_->getOpponentWidget()->layout());
+    QPushButton* cell = qobject_cast<QPushButton*>(opponentLayout->itemAtPosition(3, 3)->widget());
+    gameBoard_->flushPendingUpdates();
+    QCOMPARE(cell->styleSheet(), QString(missStyle));
+}
+
+void TestGameBoard::testResyncKeepsOpponentBoardWhenMissing() {
+    gameBoard_->parseAndSaveBoard("Your board:\nS.........\n..........\n..........\n..........\n..........\n..........\n..........\n..........\n..........\n..........");
+    gameBoard_->updateOpponentBoard(2, 2, "hit");
+
+    gameBoard_->resyncBoards("Your board:\nX.........\n..........\n..........\n..........\n..........\n..........\n..........\n..........\n..........\n..........");
+    QCOMPARE(gameBoard_->opponentBoardSecond[2][2], 'X');
+    QCOMPARE(gameBoard_->playerBoardFirst[0][0], 'X');
+    QCOMPARE(gameBoard_->history().eventCount(), 2);
+    QCOMPARE(gameBoard_->history().eventAt(1).board, GameHistory::Board::Player);
+    QCOMPARE(gameBoard_->boardHash(),
+             zobrist::boardHash(zobrist::Board::Player, gameBoard_->playerBoardFirst) ^
+                 zobrist::boardHash(zobrist::Board::Opponent, gameBoard_->opponentBoardSecond));
+}
+
+void TestGameBoard::testWidgetsAreReusedAcrossGames() {
+    gameBoard_->parseAndSaveBoard("Your board:\nS.........\n..........\n..........\n..........\n..........\n..........\n..........\n..........\n..........\n..........");
+    QWidget* playerWidget = gameBoard_->getPlayerWidget();
+    QGridLayout* playerLayout = qobject_cast<QGridLayout*>(playerWidget->layout());
+    QPushButton* cell = qobject_cast<QPushButton*>(playerLayout->itemAtPosition(0, 0)->widget());
+    QCOMPARE(cell->styleSheet(), QString(playerShipStyle));
+
+    auto* container = new QWidget();
+    auto* containerLayout = new QVBoxLayout(container);
+    containerLayout->addWidget(playerWidget);
+    QCOMPARE(playerWidget->parentWidget(), container);
+    gameBoard_->detachWidgets();
+    delete container;
+
+    gameBoard_->cleanFiledForNewGame();
+    QCOMPARE(gameBoard_->getPlayerWidget(), playerWidget);
+    QCOMPARE(playerLayout->itemAtPosition(0, 0)->widget(), cell);
+    QCOMPARE(cell->styleSheet(), QString(playerEmptyStyle));
+
+    gameBoard_->parseAndSaveBoard("Your board:\n.S........\n..........\n..........\n..........\n..........\n..........\n..........\n..........\n..........\n..........");
+    QCOMPARE(playerLayout->itemAtPosition(0, 0)->widget(), cell);
+    QCOMPARE(playerLayout->count(), boardSize * boardSize);
+    QCOMPARE(cell->styleSheet(), QString(playerEmptyStyle));
+}
+
+void TestGameBoard::testRestoreBoards() {
+    std::vector<std::vector<char>> player(boardSize, std::vector<char>(boardSize, '.'));
+    std::vector<std::vector<char>> opponent = player;
+    player[0][1] = 'S';
+    std::vector<std::vector<char>> opening = player;
+    opening[0][0] = 'S';
+    player[0][0] = 'X';
+    opponent[5][6] = 'o';
+
+    gameBoard_->cleanFiledForNewGame();
+    gameBoard_->restoreBoards(opening, player, opponent);
+    QCOMPARE(gameBoard_->openingBoard(), opening);
+    QCOMPARE(gameBoard_->history().eventCount(), 2);
+    QCOMPARE(gameBoard_->history().positionAt(0).player[0], 'S');
+    QCOMPARE(gameBoard_->history().positionAt(2).player[0], 'X');
+    QCOMPARE(gameBoard_->history().positionAt(2).opponent[56], 'o');
+    QCOMPARE(gameBoard_->playerBoardFirst, player);
+    QCOMPARE(gameBoard_->opponentBoardSecond, opponent);
+    QVERIFY(!gameBoard_->getPlayerWidget()->isHidden());
+    QCOMPARE(gameBoard_->boardHash(), zobrist::boardHash(zobrist::Board::Player, player) ^
+                                          zobrist::boardHash(zobrist::Board::Opponent, opponent));
+
+    QGridLayout* opponentLayout = qobject_cast<QGridLayout*>(gameBoard_->getOpponentWidget()->layout());
+    QPushButton* cell = qobject_cast<QPushButton*>(opponentLayout->itemAtPosition(5, 6)->widget());
+    gameBoard_->flushPendingUpdates();
+    QCOMPARE(cell->styleSheet(), QString(missStyle));
+
+    QSignalSpy changed(gameBoard_, &GameBoard::cellChanged);
+    gameBoard_->updatePlayerBoard(0, 1, "kill");
+    gameBoard_->updateOpponentBoard(1, 1, "unknown");
+    QCOMPARE(changed.count(), 1);
+    QCOMPARE(changed.at(0).at(1).toInt(), 0);
+    QCOMPARE(changed.at(0).at(2).toInt(), 1);
+}
+
 QTEST_MAIN(TestGameBoard)
 #include "test_gameboard.moc"
\ No newline at end of file
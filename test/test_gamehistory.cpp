@@ -0,0 +1,107 @@
+#include <QtTest/QtTest>
+
+#include "../src/boardcell.h"
+#include "../src/gamehistory.h"
+
+class TestGameHistory : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testStartKeepsInitialBoard();
+    void testPositionAtEveryTurn();
+    void testInvalidEventsAreIgnored();
+    void testClear();
+    void testCopyIsIndependent();
+    void testArenaIsReusedAcrossGames();
+
+private:
+    static constexpr int snapshotInterval = 4;
+};
+
+void TestGameHistory::testStartKeepsInitialBoard() {
+    GameHistory history(snapshotInterval);
+    std::vector<std::vector<char>> board(10, std::vector<char>(10, boardcell::empty));
+    board[0][0] = boardcell::ship;
+    history.start(board);
+
+    QVERIFY(history.isEmpty());
+    const GameHistory::Position position = history.positionAt(0);
+    QCOMPARE(position.player[0], boardcell::ship);
+    QCOMPARE(position.player[1], boardcell::empty);
+    QCOMPARE(position.opponent[0], boardcell::empty);
+}
+
+void TestGameHistory::testPositionAtEveryTurn() {
+    GameHistory history(snapshotInterval);
+    history.start(std::vector<std::vector<char>>(10, std::vector<char>(10, boardcell::empty)));
+
+    constexpr int turns = 23;
+    for (int i = 0; i < turns; ++i) {
+        const auto board = i % 2 ? GameHistory::Board::Opponent : GameHistory::Board::Player;
+        history.append(board, i / 10, i % 10, i % 3 ? boardcell::miss : boardcell::hit);
+    }
+    QCOMPARE(history.eventCount(), turns);
+
+    for (int turn = 0; turn <= turns; ++turn) {
+        const GameHistory::Position position = history.positionAt(turn);
+        for (int i = 0; i < turns; ++i) {
+            const auto& cells = i % 2 ? position.opponent : position.player;
+            const char expected = i < turn ? (i % 3 ? boardcell::miss : boardcell::hit) : boardcell::empty;
+            QCOMPARE(cells[i], expected);
+        }
+    }
+}
+
+void TestGameHistory::testInvalidEventsAreIgnored() {
+    GameHistory history(snapshotInterval);
+    history.append(GameHistory::Board::Player, -1, 0, boardcell::miss);
+    history.append(GameHistory::Board::Player, 0, 10, boardcell::miss);
+    history.append(GameHistory::Board::Player, 0, 0, 0);
+    QVERIFY(history.isEmpty());
+}
+
+void TestGameHistory::testClear() {
+    GameHistory history(snapshotInterval);
+    for (int i = 0; i < snapshotInterval * 2; ++i) {
+        history.append(GameHistory::Board::Opponent, 0, i, boardcell::miss);
+    }
+    history.clear();
+    QVERIFY(history.isEmpty());
+    QCOMPARE(history.positionAt(snapshotInterval).opponent[0], boardcell::empty);
+}
+
+void TestGameHistory::testCopyIsIndependent() {
+    GameHistory history(snapshotInterval);
+    for (int i = 0; i < snapshotInterval + 1; ++i) {
+        history.append(GameHistory::Board::Player, 1, i, boardcell::hit);
+    }
+    GameHistory copy(history);
+    history.clear();
+
+    QCOMPARE(copy.eventCount(), snapshotInterval + 1);
+    QCOMPARE(copy.positionAt(copy.eventCount()).player[10 + snapshotInterval], boardcell::hit);
+    QVERIFY(history.isEmpty());
+
+    GameHistory assigned;
+    assigned = copy;
+    QCOMPARE(assigned.eventCount(), copy.eventCount());
+    QCOMPARE(assigned.positionAt(1).player[10], boardcell::hit);
+}
+
+void TestGameHistory::testArenaIsReusedAcrossGames() {
+    GameHistory history;
+    const std::vector<std::vector<char>> board(10, std::vector<char>(10, boardcell::empty));
+    for (int game = 0; game < 3; ++game) {
+        history.start(board);
+        constexpr int longGame = 500;
+        for (int i = 0; i < longGame; ++i) {
+            history.append(GameHistory::Board::Opponent, (i / 10) % 10, i % 10, boardcell::miss);
+        }
+        QCOMPARE(history.eventCount(), longGame);
+        QCOMPARE(history.positionAt(longGame).opponent[99], boardcell::miss);
+        QCOMPARE(history.positionAt(0).opponent[0], boardcell::empty);
+    }
+}
+
+QTEST_MAIN(TestGameHistory)
+#include "test_gamehistory.moc"
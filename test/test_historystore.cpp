@@ -0,0 +1,139 @@
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+
+#include "../src/historystore.h"
+
+class TestHistoryStore : public QObject {
+    Q_OBJECT
+
+private slots:
+    void init();
+
+    void testEmptyStore();
+    void testAppendAndReadBack();
+    void testStatisticsAcrossBlocks();
+    void testRejectsForeignFile();
+    void testCrashBeforeGameCountIsWritten();
+
+private:
+    QString storePath() const { return tempDir_->filePath("games.dat"); }
+
+    std::unique_ptr<QTemporaryDir> tempDir_;
+};
+
+void TestHistoryStore::init() {
+    tempDir_ = std::make_unique<QTemporaryDir>();
+    QVERIFY(tempDir_->isValid());
+}
+
+void TestHistoryStore::testEmptyStore() {
+    HistoryStore store(storePath());
+    QCOMPARE(store.gameCount(), std::uint64_t(0));
+    const HistoryStore::Statistics statistics = store.statistics();
+    QCOMPARE(statistics.games, std::uint64_t(0));
+    QCOMPARE(statistics.winRate(), 0.0);
+}
+
+void TestHistoryStore::testAppendAndReadBack() {
+    HistoryStore::GameSummary game;
+    game.won = true;
+    game.shotsFired = 42;
+    game.shotsHit = 20;
+    game.firstShotCell = 55;
+    game.opponentShots.set(0);
+    game.opponentShots.set(99);
+    game.finishedAtMs = 1234567;
+
+    {
+        HistoryStore store(storePath());
+        QVERIFY(store.append(game));
+    }
+
+    HistoryStore store(storePath());
+    QCOMPARE(store.gameCount(), std::uint64_t(1));
+    const HistoryStore::GameSummary stored = store.gameAt(0);
+    QCOMPARE(stored.won, true);
+    QCOMPARE(stored.shotsFired, 42);
+    QCOMPARE(stored.shotsHit, 20);
+    QCOMPARE(stored.firstShotCell, 55);
+    QCOMPARE(stored.opponentShots, game.opponentShots);
+    QCOMPARE(stored.finishedAtMs, std::int64_t(1234567));
+}
+
+void TestHistoryStore::testStatisticsAcrossBlocks() {
+    constexpr int games = 2500;
+    HistoryStore store(storePath());
+    for (int i = 0; i < games; ++i) {
+        HistoryStore::GameSummary game;
+        game.won = i % 4 == 0;
+        game.shotsFired = 40 + i % 3;
+        game.firstShotCell = i % 2 ? 11 : -1;
+        game.opponentShots.set(i % 100);
+        QVERIFY(store.append(game));
+    }
+
+    const HistoryStore::Statistics statistics = store.statistics();
+    QCOMPARE(statistics.games, std::uint64_t(games));
+    QCOMPARE(statistics.wins, std::uint64_t(games / 4));
+    QCOMPARE(statistics.firstShotHeatmap[11], std::uint32_t(games / 2));
+    QCOMPARE(statistics.firstShotHeatmap[0], std::uint32_t(0));
+    QCOMPARE(statistics.opponentShotHeatmap[7], std::uint32_t(games / 100));
+
+    std::uint64_t shotsInWins = 0;
+    for (int i = 0; i < games; i += 4) {
+        shotsInWins += 40 + i % 3;
+    }
+    QCOMPARE(statistics.shotsInWins, shotsInWins);
+    QCOMPARE(store.gameAt(games - 1).opponentShots.test((games - 1) % 100), true);
+}
+
+void TestHistoryStore::testRejectsForeignFile() {
+    QFile foreign(storePath());
+    QVERIFY(foreign.open(QIODevice::WriteOnly));
+    foreign.write(QByteArray(128, 'x'));
+    foreign.close();
+
+    HistoryStore store(storePath());
+    QVERIFY(!store.append(HistoryStore::GameSummary()));
+    QCOMPARE(store.gameCount(), std::uint64_t(0));
+}
+
+void TestHistoryStore::testCrashBeforeGameCountIsWritten() {
+    constexpr qint64 gameCountOffset = 16;
+    HistoryStore::GameSummary lost;
+    lost.won = true;
+    lost.shotsFired = 30;
+    lost.firstShotCell = 7;
+    lost.opponentShots.set(3);
+    {
+        HistoryStore store(storePath());
+        QVERIFY(store.append(HistoryStore::GameSummary()));
+        QVERIFY(store.append(lost));
+    }
+
+    QFile file(storePath());
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    const std::uint64_t gameCount = 1;
+    QVERIFY(file.seek(gameCountOffset));
+    file.write(reinterpret_cast<const char*>(&gameCount), sizeof(gameCount));
+    file.close();
+
+    HistoryStore store(storePath());
+    QCOMPARE(store.statistics().games, std::uint64_t(1));
+    QCOMPARE(store.statistics().wins, std::uint64_t(0));
+
+    HistoryStore::GameSummary replacement;
+    replacement.shotsFired = 50;
+    replacement.firstShotCell = 9;
+    QVERIFY(store.append(replacement));
+    const HistoryStore::Statistics statistics = store.statistics();
+    QCOMPARE(statistics.games, std::uint64_t(2));
+    QCOMPARE(statistics.wins, std::uint64_t(0));
+    QCOMPARE(statistics.shotsInWins, std::uint64_t(0));
+    QCOMPARE(statistics.firstShotHeatmap[7], std::uint32_t(0));
+    QCOMPARE(statistics.firstShotHeatmap[9], std::uint32_t(1));
+    QCOMPARE(statistics.opponentShotHeatmap[3], std::uint32_t(0));
+}
+
+QTEST_MAIN(TestHistoryStore)
+#include "test_historystore.moc"
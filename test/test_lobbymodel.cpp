@@ -0,0 +1,160 @@
+#include <QtTest/QtTest>
+
+#include "../src/lobbymodel.h"
+
+class TestLobbyModel : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testIncrementalDeltas();
+    void testUpdateAndRemove();
+    void testFilterAndSortOffThread();
+    void testDeltasDuringRefresh();
+    void testReaddDuringRefresh();
+    void testClearResetsQuery();
+    void testBulkMessage();
+
+private:
+    static QStringList visibleIds(const LobbyModel& model);
+};
+
+QStringList TestLobbyModel::visibleIds(const LobbyModel& model) {
+    QStringList ids;
+    for (int row = 0; row < model.rowCount(); ++row) {
+        ids << model.sessionIdAt(row);
+    }
+    return ids;
+}
+
+void TestLobbyModel::testIncrementalDeltas() {
+    LobbyModel model;
+    QSignalSpy inserted(&model, &QAbstractItemModel::rowsInserted);
+    QSignalSpy reset(&model, &QAbstractItemModel::modelReset);
+
+    QVERIFY(model.applyMessage("Lobby add: alpha 1"));
+    QVERIFY(model.applyMessage("Lobby add: beta 1\nLobby add: gamma 2"));
+    QVERIFY(!model.applyMessage("Your turn"));
+
+    QCOMPARE(inserted.count(), 3);
+    QCOMPARE(reset.count(), 0);
+    QCOMPARE(visibleIds(model), QStringList({"gamma", "beta", "alpha"}));
+    QCOMPARE(model.data(model.index(0), Qt::DisplayRole).toString(), QString("gamma (2/2)"));
+    QCOMPARE(model.data(model.index(0), LobbyModel::PlayersRole).toInt(), 2);
+}
+
+void TestLobbyModel::testUpdateAndRemove() {
+    LobbyModel model;
+    model.applyMessage("Lobby add: alpha 1\nLobby add: beta 1\nLobby add: gamma 1");
+
+    QSignalSpy changed(&model, &QAbstractItemModel::dataChanged);
+    model.applyMessage("Lobby update: beta 2");
+    QCOMPARE(changed.count(), 1);
+    QCOMPARE(model.data(model.index(1), LobbyModel::PlayersRole).toInt(), 2);
+
+    QSignalSpy removed(&model, &QAbstractItemModel::rowsRemoved);
+    model.applyMessage("Lobby remove: gamma");
+    QCOMPARE(removed.count(), 1);
+    QCOMPARE(visibleIds(model), QStringList({"beta", "alpha"}));
+    QCOMPARE(model.sessionCount(), 2);
+
+    model.applyMessage("Lobby remove: alpha");
+    model.applyMessage("Lobby add: delta 1");
+    QCOMPARE(visibleIds(model), QStringList({"delta", "beta"}));
+}
+
+void TestLobbyModel::testFilterAndSortOffThread() {
+    LobbyModel model;
+    model.applyMessage("Lobby add: room-b 2\nLobby add: hall-a 1\nLobby add: room-a 1");
+
+    QSignalSpy finished(&model, &LobbyModel::refreshFinished);
+    model.setFilterText("ROOM");
+    QVERIFY(model.isRefreshing());
+    QTRY_COMPARE(finished.count(), 1);
+    QCOMPARE(visibleIds(model), QStringList({"room-a", "room-b"}));
+
+    model.setSortKey(LobbyModel::SortKey::SessionId);
+    QTRY_COMPARE(finished.count(), 2);
+    QCOMPARE(visibleIds(model), QStringList({"room-a", "room-b"}));
+
+    model.setSortKey(LobbyModel::SortKey::Players);
+    QTRY_COMPARE(finished.count(), 3);
+    model.applyMessage("Lobby update: room-a 2\nLobby add: room-c 0\nLobby add: hall-b 0");
+    QCOMPARE(visibleIds(model), QStringList({"room-c", "room-a", "room-b"}));
+}
+
+void TestLobbyModel::testDeltasDuringRefresh() {
+    LobbyModel model;
+    for (int i = 0; i < 1000; ++i) {
+        model.addSession(QString("s%1").arg(i, 4, 10, QChar('0')), 1);
+    }
+
+    QSignalSpy finished(&model, &LobbyModel::refreshFinished);
+    model.setSortKey(LobbyModel::SortKey::SessionId);
+    model.addSession("s9999", 1);
+    model.removeSession("s0000");
+    model.updateSession("s0001", 2);
+    QTRY_VERIFY(!model.isRefreshing());
+
+    QCOMPARE(model.rowCount(), 1000);
+    QCOMPARE(model.sessionIdAt(0), QString("s0001"));
+    QCOMPARE(model.sessionIdAt(999), QString("s9999"));
+    QCOMPARE(model.data(model.index(0), LobbyModel::PlayersRole).toInt(), 2);
+}
+
+void TestLobbyModel::testReaddDuringRefresh() {
+    LobbyModel model;
+    for (int i = 0; i < 100; ++i) {
+        model.addSession(QString("s%1").arg(i, 3, 10, QChar('0')), 1);
+    }
+
+    model.setSortKey(LobbyModel::SortKey::SessionId);
+    model.removeSession("s050");
+    model.addSession("s050", 2);
+    QTRY_VERIFY(!model.isRefreshing());
+
+    const QStringList ids = visibleIds(model);
+    QCOMPARE(ids.size(), 100);
+    QCOMPARE(ids.count("s050"), 1);
+    QStringList sorted = ids;
+    sorted.sort();
+    QCOMPARE(ids, sorted);
+    QCOMPARE(model.data(model.index(50), LobbyModel::PlayersRole).toInt(), 2);
+}
+
+void TestLobbyModel::testClearResetsQuery() {
+    LobbyModel model;
+    model.applyMessage("Lobby add: room-a 1\nLobby add: hall-a 1");
+    QSignalSpy finished(&model, &LobbyModel::refreshFinished);
+    model.setFilterText("room");
+    QTRY_COMPARE(finished.count(), 1);
+
+    model.setSortKey(LobbyModel::SortKey::Players);
+    QVERIFY(model.isRefreshing());
+    model.clear();
+    model.applyMessage("Lobby add: hall-b 1\nLobby add: room-b 2");
+    QTRY_VERIFY(!model.isRefreshing());
+
+    QCOMPARE(finished.count(), 1);
+    QCOMPARE(visibleIds(model), QStringList({"room-b", "hall-b"}));
+}
+
+void TestLobbyModel::testBulkMessage() {
+    constexpr int sessions = 20000;
+    QString message;
+    for (int i = 0; i < sessions; ++i) {
+        message += QString("Lobby add: session%1 1\n").arg(i);
+    }
+
+    LobbyModel model;
+    QSignalSpy inserted(&model, &QAbstractItemModel::rowsInserted);
+    QSignalSpy finished(&model, &LobbyModel::refreshFinished);
+    model.applyMessage(message);
+    QCOMPARE(inserted.count(), 0);
+    QTRY_COMPARE(finished.count(), 1);
+
+    QCOMPARE(model.rowCount(), sessions);
+    QCOMPARE(model.sessionIdAt(0), QString("session%1").arg(sessions - 1));
+}
+
+QTEST_MAIN(TestLobbyModel)
+#include "test_lobbymodel.moc"
@@ -4,8 +4,52 @@
 #include <QLabel>
 #include <QWebSocket>
 
+#include "../src/directtransport.h"
 #include "../src/mainwindow.h"
 
+namespace {
+constexpr auto serverUrlVariable = "SEA_BATTLE_SERVER_URL";
+constexpr auto directServerUrl = "direct://mainwindow-test";
+constexpr auto directServerName = "mainwindow-test";
+constexpr auto boardMessage =
+    "Your board:\nS.........\n..........\n..........\n..........\n..........\n..........\n..........\n"
+    "..........\n..........\n..........";
+constexpr auto opponentBoardMessage =
+    "Opponent board:\n..........\n..........\n..........\n..........\n....X.....\n..........\n..........\n"
+    "..........\n..........\n..........";
+constexpr int resyncRetryWaitMs = 5000;
+constexpr int resumeAttempts = 3;
+constexpr int shotCycles = 10;
+constexpr int frameSettleMs = 50;
+constexpr int boardSize = 10;
+
+class FakeServer : public QObject {
+public:
+    FakeServer() {
+        server.listen(directServerName);
+        connect(&server, &DirectTransportServer::newConnection, this, [this](DirectTransport* transport) {
+            connection = transport;
+            connect(transport, &Transport::textMessageReceived, this,
+                    [this](const QString& message) { received << message; });
+        });
+    }
+
+    void send(const QString& message) { connection->sendTextMessage(message); }
+
+    DirectTransportServer server;
+    QPointer<DirectTransport> connection;
+    QStringList received;
+};
+
+std::unique_ptr<MainWindow> createDirectWindow(const char* url = directServerUrl) {
+    qputenv(serverUrlVariable, url);
+    auto window = std::make_unique<MainWindow>();
+    qunsetenv(serverUrlVariable);
+    window->setTestingMode(true);
+    return window;
+}
+}
+
 class TestMainWindow : public QObject {
     Q_OBJECT
 
@@ -15,6 +59,10 @@ private slots:
     void testCreateSessionEmptyInput();
     void testJoinSessionEmptyInput();
     void testJoinSessionValidInput();
+    void testResyncRetriesUntilAnswered();
+    void testShotCycleAllocations();
+    void testResumesAfterRestart();
+    void testUnansweredResumeReturnsToMenu();
 
 private:
     MainWindow* mainWindow_ = nullptr;
@@ -25,6 +73,7 @@ private:
 };
 
 void TestMainWindow::initTestCase() {
+    QStandardPaths::setTestModeEnabled(true);
     mainWindow_ = new MainWindow();
     QVERIFY(mainWindow_ != nullptr);
     mainWindow_->setTestingMode(true);
@@ -100,5 +149,144 @@ void TestMainWindow::testJoinSessionValidInput() {
     QCOMPARE(mainWindow_->getLastSentMessage(), QString("join:%1").arg(testSessionId));
 }
 
+void TestMainWindow::testResyncRetriesUntilAnswered() {
+    FakeServer server;
+    std::unique_ptr<MainWindow> window = createDirectWindow();
+    QTRY_VERIFY(server.connection);
+    GameBoard* gameBoard = window->findChild<GameBoard*>();
+    QVERIFY(gameBoard);
+
+    server.send(QString("Connected to session: room\n") + boardMessage);
+    server.send("Shot result: hit");
+    QTRY_COMPARE(server.received.count("resync:room"), 1);
+    QTRY_COMPARE_WITH_TIMEOUT(server.received.count("resync:room"), 2, resyncRetryWaitMs);
+
+    server.send(QString(boardMessage) + "\n" + opponentBoardMessage);
+    QTRY_COMPARE(gameBoard->opponentBoardSecond[4][4], 'X');
+    QCOMPARE(gameBoard->history().eventCount(), 1);
+    QTest::qWait(resyncRetryWaitMs / 2);
+    QCOMPARE(server.received.count("resync:room"), 2);
+
+    server.send("Shot result: miss");
+    QTRY_COMPARE(server.received.count("resync:room"), 3);
+    window.reset();
+    SessionSnapshot(SessionSnapshot::defaultFilePath()).clear();
+}
+
+void TestMainWindow::testShotCycleAllocations() {
+    if (!allocationcounter::isEnabled()) {
+        QSKIP("Allocation counting is compiled out");
+    }
+    FakeServer server;
+    std::unique_ptr<MainWindow> window = createDirectWindow();
+    QTRY_VERIFY(server.connection);
+    GameBoard* gameBoard = window->findChild<GameBoard*>();
+    QVERIFY(gameBoard);
+    QSignalSpy frames(gameBoard, &GameBoard::frameRendered);
+    const AllocationLedger& ledger = window->getAllocationLedger();
+
+    const QString newGame = QString("Connected to session: room\n") + boardMessage;
+    const auto playGame = [&] {
+        server.send(newGame);
+        for (int i = 0; i < shotCycles; ++i) {
+            const auto cycle = quint64(i + 1);
+            server.send("Your turn");
+            QTRY_COMPARE(ledger.entry(AllocationLedger::MessageType::Turn).messages, cycle);
+            window->onCellClicked(i % boardSize, i / boardSize);
+            server.send("Shot result: miss");
+            server.send(QString("Opponent shot at (%1, %2): miss").arg(i / boardSize + 1).arg(i % boardSize));
+            QTRY_COMPARE(ledger.entry(AllocationLedger::MessageType::OpponentShot).messages, cycle);
+            QTest::qWait(frameSettleMs);
+        }
+    };
+
+    playGame();
+    QVERIFY(!frames.isEmpty());
+    const double warmUpPerCycle = ledger.allocationsPerShotCycle();
+    playGame();
+    QCOMPARE(ledger.entry(AllocationLedger::MessageType::Shoot).messages, quint64(shotCycles));
+    qInfo().noquote() << ledger.report();
+
+    // Every shot is queued to the server as an event, so a cycle over a live transport always allocates.
+    const double perCycle = ledger.allocationsPerShotCycle();
+    QVERIFY(perCycle >= 1.0);
+    QVERIFY(perCycle <= warmUpPerCycle);
+
+    window.reset();
+    SessionSnapshot(SessionSnapshot::defaultFilePath()).clear();
+}
+
+void TestMainWindow::testResumesAfterRestart() {
+    delete mainWindow_;
+    mainWindow_ = nullptr;
+
+    SessionSnapshot::State savedGame;
+    savedGame.sessionId = "room";
+    savedGame.openingBoard.assign(boardSize, std::vector<char>(boardSize, '.'));
+    savedGame.openingBoard[0][0] = 'S';
+    savedGame.playerBoard = savedGame.openingBoard;
+    savedGame.playerBoard[0][0] = 'X';
+    savedGame.opponentBoard.assign(boardSize, std::vector<char>(boardSize, '.'));
+    savedGame.opponentBoard[4][4] = 'X';
+    savedGame.myTurn = true;
+    savedGame.sequence = 2;
+    QVERIFY(SessionSnapshot(SessionSnapshot::defaultFilePath()).store(savedGame));
+
+    FakeServer server;
+    std::unique_ptr<MainWindow> window = createDirectWindow();
+    GameBoard* gameBoard = window->findChild<GameBoard*>();
+    QVERIFY(gameBoard);
+    QCOMPARE(gameBoard->playerBoardFirst, savedGame.playerBoard);
+    QCOMPARE(gameBoard->opponentBoardSecond, savedGame.opponentBoard);
+    QCOMPARE(gameBoard->openingBoard(), savedGame.openingBoard);
+    QCOMPARE(gameBoard->history().eventCount(), 2);
+
+    QTRY_VERIFY(server.received.contains("resume:room:2"));
+    const QString serverOpponentBoard =
+        QString(opponentBoardMessage).replace("....X.....\n..........", "....X.....\n.....o....");
+    server.send(QString("Your board:\nX.........\n..........\n..........\n..........\n..........\n..........\n"
+                        "..........\n..........\n..........\n..........\n") +
+                serverOpponentBoard);
+    QTRY_COMPARE(gameBoard->opponentBoardSecond[5][5], 'o');
+    QCOMPARE(gameBoard->history().eventCount(), 3);
+
+    const std::optional<SessionSnapshot::State> stored = SessionSnapshot(SessionSnapshot::defaultFilePath()).restore();
+    QVERIFY(stored);
+    QCOMPARE(stored->opponentBoard[5][5], 'o');
+    QCOMPARE(stored->openingBoard, savedGame.openingBoard);
+
+    window.reset();
+    SessionSnapshot(SessionSnapshot::defaultFilePath()).clear();
+}
+
+void TestMainWindow::testUnansweredResumeReturnsToMenu() {
+    delete mainWindow_;
+    mainWindow_ = nullptr;
+
+    SessionSnapshot::State savedGame;
+    savedGame.sessionId = "room";
+    savedGame.openingBoard.assign(boardSize, std::vector<char>(boardSize, '.'));
+    savedGame.openingBoard[0][0] = 'S';
+    savedGame.playerBoard = savedGame.openingBoard;
+    savedGame.opponentBoard.assign(boardSize, std::vector<char>(boardSize, '.'));
+    savedGame.sequence = 1;
+    QVERIFY(SessionSnapshot(SessionSnapshot::defaultFilePath()).store(savedGame));
+
+    FakeServer server;
+    std::unique_ptr<MainWindow> window = createDirectWindow();
+    QTRY_COMPARE(server.received.count("resume:room:1"), 1);
+    QTRY_COMPARE_WITH_TIMEOUT(server.received.count("resume:room:1"), resumeAttempts, resyncRetryWaitMs * 2);
+
+    QTRY_VERIFY_WITH_TIMEOUT(!SessionSnapshot(SessionSnapshot::defaultFilePath()).restore(), resyncRetryWaitMs);
+    bool backInMenu = false;
+    for (QPushButton* button : window->findChildren<QPushButton*>()) {
+        backInMenu = backInMenu or button->text() == QString(createSessionText);
+    }
+    QVERIFY(backInMenu);
+    QCOMPARE(server.received.count("resume:room:1"), resumeAttempts);
+
+    window.reset();
+}
+
 QTEST_MAIN(TestMainWindow)
-#include "test_mainwindow.moc"
\ No newline at end of file
+#include "test_mainwindow.moc"
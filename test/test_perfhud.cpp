@@ -0,0 +1,140 @@
+#include <QtTest/QtTest>
+#include <QHBoxLayout>
+
+#include "../src/allocationcounter.h"
+#include "../src/perfhud.h"
+
+namespace {
+constexpr auto boardMessage = "Your board:\nSS........\n..........\n..........\n..........\n..........\n"
+                              "..........\n..........\n..........\n..........\n..........";
+constexpr int boardCells = 100;
+constexpr int siblingPaintMs = 20;
+}
+
+class TestPerfHud : public QObject {
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+    void testStartsHiddenAndToggles();
+    void testObjectCounts();
+    void testRecordsBoardFrames();
+    void testIdleFramesAreSkipped();
+    void testHiddenHudDoesNotSample();
+    void testFilterPassesEventsThrough();
+    void testBoardPaintEndsAtOtherWidget();
+
+private:
+    QWidget* window_ = nullptr;
+    GameBoard* gameBoard_ = nullptr;
+    PerfHud* hud_ = nullptr;
+};
+
+void TestPerfHud::init() {
+    window_ = new QWidget();
+    window_->resize(800, 600);
+    gameBoard_ = new GameBoard(window_);
+    auto* layout = new QHBoxLayout(window_);
+    layout->addWidget(gameBoard_->getPlayerWidget());
+    layout->addWidget(gameBoard_->getOpponentWidget());
+    gameBoard_->parseAndSaveBoard(boardMessage);
+    hud_ = new PerfHud(window_, gameBoard_);
+    window_->show();
+    QVERIFY(QTest::qWaitForWindowExposed(window_));
+}
+
+void TestPerfHud::cleanup() {
+    delete window_;
+    window_ = nullptr;
+    gameBoard_ = nullptr;
+    hud_ = nullptr;
+}
+
+void TestPerfHud::testStartsHiddenAndToggles() {
+    QVERIFY(!hud_->isVisible());
+    hud_->toggle();
+    QVERIFY(hud_->isVisible());
+    QVERIFY(hud_->x() + hud_->width() <= window_->width());
+    hud_->toggle();
+    QVERIFY(!hud_->isVisible());
+}
+
+void TestPerfHud::testObjectCounts() {
+    const PerfHud::ObjectCounts counts = hud_->objectCounts();
+    QCOMPARE(counts.gameBoardWidgets, 2 + boardCells * 2);
+    QVERIFY(counts.gameBoardObjects > counts.gameBoardWidgets);
+    QCOMPARE(counts.mainWindowWidgets, static_cast<int>(window_->findChildren<QWidget*>().size()));
+    QVERIFY(counts.mainWindowObjects >= counts.gameBoardObjects);
+}
+
+void TestPerfHud::testRecordsBoardFrames() {
+    hud_->show();
+    QTest::qWait(50);
+
+    gameBoard_->setOpponentBoardClickOrNot(true);
+    gameBoard_->updateOpponentBoard(4, 4, "hit");
+    gameBoard_->updatePlayerBoard(0, 0, "kill");
+    QTRY_VERIFY(!hud_->recentFrames().empty());
+
+    const PerfHud::FrameSample& frame = hud_->recentFrames().back();
+    QVERIFY(frame.updateNs > 0);
+    QVERIFY(frame.boardPaintNs > 0);
+    QVERIFY(frame.frameNs >= frame.updateNs);
+    QVERIFY(frame.repolishes >= 2);
+    if (!allocationcounter::isEnabled()) {
+        QCOMPARE(frame.allocations, quint64(0));
+    }
+}
+
+void TestPerfHud::testIdleFramesAreSkipped() {
+    hud_->show();
+    QTest::qWait(50);
+    const size_t frames = hud_->recentFrames().size();
+
+    hud_->update();
+    QTest::qWait(50);
+    QCOMPARE(hud_->recentFrames().size(), frames);
+}
+
+void TestPerfHud::testHiddenHudDoesNotSample() {
+    gameBoard_->updateOpponentBoard(1, 1, "miss");
+    gameBoard_->flushPendingUpdates();
+    QTest::qWait(50);
+    QVERIFY(hud_->recentFrames().empty());
+}
+
+void TestPerfHud::testFilterPassesEventsThrough() {
+    hud_->show();
+    QObject* filter = hud_;
+    QWidget* boardWidget = gameBoard_->getPlayerWidget();
+
+    QEvent updateRequest(QEvent::UpdateRequest);
+    QPaintEvent paint(boardWidget->rect());
+    QVERIFY(!filter->eventFilter(window_, &updateRequest));
+    QVERIFY(!filter->eventFilter(boardWidget, &paint));
+    QTRY_VERIFY(!hud_->recentFrames().empty());
+    QVERIFY(hud_->recentFrames().back().boardPaintNs > 0);
+}
+
+void TestPerfHud::testBoardPaintEndsAtOtherWidget() {
+    hud_->show();
+    QObject* filter = hud_;
+    QWidget* boardWidget = gameBoard_->getOpponentWidget();
+
+    QEvent updateRequest(QEvent::UpdateRequest);
+    QPaintEvent boardPaint(boardWidget->rect());
+    QPaintEvent siblingPaint(hud_->rect());
+    QVERIFY(!filter->eventFilter(window_, &updateRequest));
+    QVERIFY(!filter->eventFilter(boardWidget, &boardPaint));
+    QVERIFY(!filter->eventFilter(hud_, &siblingPaint));
+    QTest::qSleep(siblingPaintMs);
+    QTRY_VERIFY(!hud_->recentFrames().empty());
+
+    const PerfHud::FrameSample& frame = hud_->recentFrames().back();
+    QVERIFY(frame.boardPaintNs > 0);
+    QVERIFY(frame.boardPaintNs < qint64(siblingPaintMs) * 1'000'000);
+}
+
+QTEST_MAIN(TestPerfHud)
+#include "test_perfhud.moc"
@@ -0,0 +1,155 @@
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+#include <cstring>
+
+#include "../src/boardcell.h"
+#include "../src/sessionsnapshot.h"
+
+class TestSessionSnapshot : public QObject {
+    Q_OBJECT
+
+private slots:
+    void init();
+    void testMissingFile();
+    void testStoreAndRestore();
+    void testInPlaceUpdatesSurviveRestart();
+    void testClear();
+    void testRejectsLongSessionId();
+    void testCorruptFile();
+    void testRestoreLeavesOlderRecordUntouched();
+
+private:
+    static SessionSnapshot::State sampleState();
+
+    std::unique_ptr<QTemporaryDir> directory_;
+    QString filePath_;
+};
+
+void TestSessionSnapshot::init() {
+    directory_ = std::make_unique<QTemporaryDir>();
+    QVERIFY(directory_->isValid());
+    filePath_ = directory_->filePath("session.snapshot");
+}
+
+SessionSnapshot::State TestSessionSnapshot::sampleState() {
+    SessionSnapshot::State state;
+    state.sessionId = "комната-7";
+    state.playerBoard.assign(SessionSnapshot::SIZE, std::vector<char>(SessionSnapshot::SIZE, boardcell::empty));
+    state.opponentBoard = state.playerBoard;
+    state.playerBoard[0][0] = boardcell::ship;
+    state.playerBoard[0][1] = boardcell::ship;
+    state.openingBoard = state.playerBoard;
+    state.playerBoard[0][1] = boardcell::hit;
+    state.playerBoard[9][9] = boardcell::miss;
+    state.opponentBoard[4][5] = boardcell::hit;
+    state.myTurn = true;
+    state.sequence = 12;
+    return state;
+}
+
+void TestSessionSnapshot::testMissingFile() {
+    SessionSnapshot snapshot(filePath_);
+    QVERIFY(!snapshot.restore());
+    snapshot.clear();
+    QVERIFY(!QFile::exists(filePath_));
+    QVERIFY(!snapshot.isActive());
+}
+
+void TestSessionSnapshot::testStoreAndRestore() {
+    const SessionSnapshot::State state = sampleState();
+    {
+        SessionSnapshot snapshot(filePath_);
+        QVERIFY(snapshot.store(state));
+        QVERIFY(snapshot.isActive());
+    }
+
+    SessionSnapshot restarted(filePath_);
+    const std::optional<SessionSnapshot::State> restored = restarted.restore();
+    QVERIFY(restored);
+    QCOMPARE(restored->sessionId, state.sessionId);
+    QCOMPARE(restored->openingBoard, state.openingBoard);
+    QCOMPARE(restored->playerBoard, state.playerBoard);
+    QCOMPARE(restored->opponentBoard, state.opponentBoard);
+    QCOMPARE(restored->myTurn, true);
+    QCOMPARE(restored->sequence, quint64(12));
+    QCOMPARE(QFileInfo(filePath_).size(), qint64(168));
+}
+
+void TestSessionSnapshot::testInPlaceUpdatesSurviveRestart() {
+    SessionSnapshot snapshot(filePath_);
+    QVERIFY(snapshot.store(sampleState()));
+    snapshot.setCell(GameHistory::Board::Opponent, 2, 3, boardcell::miss);
+    snapshot.setCell(GameHistory::Board::Player, 0, 0, boardcell::hit);
+    snapshot.setCell(GameHistory::Board::Player, 10, 0, boardcell::hit);
+    snapshot.setMyTurn(false);
+    QCOMPARE(snapshot.sequence(), quint64(14));
+
+    SessionSnapshot restarted(filePath_);
+    const std::optional<SessionSnapshot::State> restored = restarted.restore();
+    QVERIFY(restored);
+    QCOMPARE(restored->opponentBoard[2][3], boardcell::miss);
+    QCOMPARE(restored->opponentBoard[4][5], boardcell::hit);
+    QCOMPARE(restored->playerBoard[0][0], boardcell::hit);
+    QCOMPARE(restored->playerBoard[0][1], boardcell::hit);
+    QCOMPARE(restored->playerBoard[9][9], boardcell::miss);
+    QCOMPARE(restored->myTurn, false);
+    QCOMPARE(restored->sequence, quint64(14));
+}
+
+void TestSessionSnapshot::testClear() {
+    SessionSnapshot snapshot(filePath_);
+    QVERIFY(snapshot.store(sampleState()));
+    snapshot.clear();
+    QVERIFY(!snapshot.isActive());
+    snapshot.setCell(GameHistory::Board::Player, 1, 1, boardcell::miss);
+    QCOMPARE(snapshot.sequence(), quint64(0));
+
+    SessionSnapshot restarted(filePath_);
+    QVERIFY(!restarted.restore());
+}
+
+void TestSessionSnapshot::testRejectsLongSessionId() {
+    SessionSnapshot snapshot(filePath_);
+    QVERIFY(snapshot.store(sampleState()));
+
+    SessionSnapshot::State state = sampleState();
+    state.sessionId = QString(SessionSnapshot::maxSessionIdBytes + 1, QChar('x'));
+    QVERIFY(!snapshot.store(state));
+    QVERIFY(!snapshot.isActive());
+}
+
+void TestSessionSnapshot::testCorruptFile() {
+    QFile file(filePath_);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write(QByteArray(37, '\x7f'));
+    file.close();
+
+    SessionSnapshot snapshot(filePath_);
+    QVERIFY(!snapshot.restore());
+    snapshot.clear();
+    QCOMPARE(QFileInfo(filePath_).size(), qint64(37));
+    QVERIFY(snapshot.store(sampleState()));
+    QVERIFY(snapshot.restore());
+}
+
+void TestSessionSnapshot::testRestoreLeavesOlderRecordUntouched() {
+    constexpr int previousVersionSize = 144;
+    QByteArray foreign(previousVersionSize, '\0');
+    const quint32 header[] = {0x53425353, 1};
+    std::memcpy(foreign.data(), header, sizeof(header));
+    foreign[16] = 1;
+    QFile file(filePath_);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write(foreign);
+    file.close();
+
+    {
+        SessionSnapshot snapshot(filePath_);
+        QVERIFY(!snapshot.restore());
+    }
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QCOMPARE(file.readAll(), foreign);
+}
+
+QTEST_MAIN(TestSessionSnapshot)
+#include "test_sessionsnapshot.moc"
@@ -0,0 +1,113 @@
+#include <QtTest/QtTest>
+
+#include "../src/boardcell.h"
+#include "../src/spectatorwall.h"
+
+class TestSpectatorWall : public QObject {
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void testAddAndRemoveGames();
+    void testUpdatesApplyToModel();
+    void testUpdatesAreCoalescedPerFrame();
+    void testUnchangedBoardSkipsFrame();
+    void testOffscreenGamesAreCulled();
+
+private:
+    SpectatorWall* wall_ = nullptr;
+    static constexpr int frameWaitMs = 50;
+    static constexpr int spritesPerGame = 200;
+};
+
+void TestSpectatorWall::init() {
+    wall_ = new SpectatorWall();
+    wall_->resize(300, 200);
+    wall_->show();
+    QVERIFY(QTest::qWaitForWindowExposed(wall_));
+}
+
+void TestSpectatorWall::cleanup() {
+    delete wall_;
+    wall_ = nullptr;
+}
+
+void TestSpectatorWall::testAddAndRemoveGames() {
+    wall_->addGame("first");
+    wall_->addGame("second");
+    wall_->addGame("first");
+    QCOMPARE(wall_->gameCount(), 2);
+
+    wall_->removeGame("first");
+    QCOMPARE(wall_->gameCount(), 1);
+    QCOMPARE(wall_->cellAt("second", false, 0, 0), boardcell::empty);
+    QCOMPARE(wall_->cellAt("first", false, 0, 0), char(0));
+}
+
+void TestSpectatorWall::testUpdatesApplyToModel() {
+    wall_->addGame("game");
+    std::vector<std::vector<char>> board(10, std::vector<char>(10, boardcell::empty));
+    board[2][3] = boardcell::ship;
+    wall_->setPlayerBoard("game", board);
+
+    wall_->updatePlayerBoard("game", 2, 3, "hit");
+    wall_->updatePlayerBoard("game", 0, 0, "miss");
+    wall_->updateOpponentBoard("game", 5, 5, "kill");
+
+    QCOMPARE(wall_->cellAt("game", false, 2, 3), boardcell::hit);
+    QCOMPARE(wall_->cellAt("game", false, 0, 0), boardcell::miss);
+    QCOMPARE(wall_->cellAt("game", true, 5, 5), boardcell::hit);
+    QCOMPARE(wall_->cellAt("game", true, 0, 0), boardcell::empty);
+}
+
+void TestSpectatorWall::testUpdatesAreCoalescedPerFrame() {
+    wall_->addGame("game");
+    QTest::qWait(frameWaitMs);
+
+    wall_->updateOpponentBoard("game", 0, 0, "miss");
+    wall_->updateOpponentBoard("game", 0, 1, "miss");
+    wall_->updateOpponentBoard("game", 0, 1, "hit");
+    wall_->updatePlayerBoard("game", 3, 3, "miss");
+    wall_->updatePlayerBoard("game", 3, 3, "hit");
+    QTest::qWait(frameWaitMs);
+
+    QCOMPARE(wall_->cellAt("game", true, 0, 1), 'X');
+    QCOMPARE(wall_->cellAt("game", false, 3, 3), 'X');
+    QCOMPARE(wall_->lastFrameSpriteCount(), 3);
+}
+
+void TestSpectatorWall::testUnchangedBoardSkipsFrame() {
+    wall_->addGame("game");
+    QTest::qWait(frameWaitMs);
+
+    std::vector<std::vector<char>> board(10, std::vector<char>(10, boardcell::empty));
+    board[1][1] = boardcell::ship;
+    wall_->setPlayerBoard("game", board);
+    QTest::qWait(frameWaitMs);
+    QCOMPARE(wall_->lastFrameSpriteCount(), 1);
+
+    wall_->setPlayerBoard("game", board);
+    QTest::qWait(frameWaitMs);
+    QCOMPARE(wall_->lastFrameSpriteCount(), 1);
+}
+
+void TestSpectatorWall::testOffscreenGamesAreCulled() {
+    constexpr int gamesTotal = 500;
+    for (int i = 0; i < gamesTotal; ++i) {
+        wall_->addGame(QString::number(i));
+    }
+    QTest::qWait(frameWaitMs);
+
+    QVERIFY(wall_->lastFrameSpriteCount() > 0);
+    QVERIFY(wall_->lastFrameSpriteCount() < gamesTotal * spritesPerGame / 10);
+
+    wall_->updatePlayerBoard(QString::number(gamesTotal - 1), 0, 0, "miss");
+    QTest::qWait(frameWaitMs);
+    QCOMPARE(wall_->lastFrameSpriteCount(), 0);
+    QCOMPARE(wall_->cellAt(QString::number(gamesTotal - 1), false, 0, 0), boardcell::miss);
+}
+
+QTEST_MAIN(TestSpectatorWall)
+#include "test_spectatorwall.moc"
@@ -0,0 +1,225 @@
+#include <QtTest/QtTest>
+#include <QLocalServer>
+#include <QtEndian>
+#include <QWebSocketServer>
+
+#include "../src/directtransport.h"
+#include "../src/localsockettransport.h"
+#include "../src/websockettransport.h"
+
+namespace {
+constexpr int waitTimeoutMs = 5000;
+constexpr int throughputMessages = 1000;
+constexpr auto benchmarkMessage = "Opponent shot at (3, 4): hit";
+
+bool waitForCount(const QSignalSpy& spy, int count) {
+    QElapsedTimer timer;
+    timer.start();
+    while (spy.count() < count and timer.elapsed() < waitTimeoutMs) {
+        QCoreApplication::processEvents(QEventLoop::AllEvents);
+    }
+    return spy.count() >= count;
+}
+
+class EchoServer : public QObject {
+public:
+    explicit EchoServer(const QString& scheme) {
+        const QString name = QString("seabattle-bench-%1").arg(QCoreApplication::applicationPid());
+        if (scheme == "ws") {
+            auto* server = new QWebSocketServer(QString(), QWebSocketServer::NonSecureMode, this);
+            server->listen(QHostAddress::LocalHost, 0);
+            serverUrl = QUrl(QString("ws://127.0.0.1:%1").arg(server->serverPort()));
+            connect(server, &QWebSocketServer::newConnection, this, [this, server] {
+                echo(new WebSocketTransport(server->nextPendingConnection(), this));
+            });
+        } else if (scheme == "local") {
+            QLocalServer::removeServer(name);
+            auto* server = new QLocalServer(this);
+            server->listen(name);
+            serverUrl = QUrl(QString("local:%1").arg(name));
+            connect(server, &QLocalServer::newConnection, this, [this, server] {
+                echo(new LocalSocketTransport(server->nextPendingConnection(), this));
+            });
+        } else {
+            auto* server = new DirectTransportServer(this);
+            server->listen(name);
+            serverUrl = QUrl(QString("direct://%1").arg(name));
+            connect(server, &DirectTransportServer::newConnection, this,
+                    [this](DirectTransport* transport) { echo(transport); });
+        }
+    }
+
+    QUrl url() const { return serverUrl; }
+
+private:
+    void echo(Transport* transport) {
+        connect(transport, &Transport::textMessageReceived, transport,
+                [transport](const QString& message) { transport->sendTextMessage(message); });
+    }
+
+    QUrl serverUrl;
+};
+}
+
+class TestTransport : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testCreateBySchema();
+    void testLocalFrameEncoding();
+    void testEchoRoundTrip_data();
+    void testEchoRoundTrip();
+    void testDirectDisconnect();
+    void testDirectMissingServer();
+    void testLocalMissingServer();
+    void benchmarkLatency_data();
+    void benchmarkLatency();
+    void benchmarkThroughput_data();
+    void benchmarkThroughput();
+
+private:
+    static void addTransportRows();
+};
+
+void TestTransport::addTransportRows() {
+    QTest::addColumn<QString>("scheme");
+    QTest::newRow("websocket") << QString("ws");
+    QTest::newRow("localsocket") << QString("local");
+    QTest::newRow("direct") << QString("direct");
+}
+
+void TestTransport::testCreateBySchema() {
+    std::unique_ptr<Transport> webSocket(Transport::create(QUrl("ws://localhost:8080")));
+    std::unique_ptr<Transport> local(Transport::create(QUrl("local:seabattle")));
+    std::unique_ptr<Transport> direct(Transport::create(QUrl("direct://bots")));
+    std::unique_ptr<Transport> secureWebSocket(Transport::create(QUrl("wss://localhost:8443")));
+    QTest::ignoreMessage(QtWarningMsg, "Unknown transport scheme \"http\", falling back to WebSocket");
+    std::unique_ptr<Transport> unknown(Transport::create(QUrl("http://localhost:8080")));
+    QVERIFY(qobject_cast<WebSocketTransport*>(webSocket.get()));
+    QVERIFY(qobject_cast<WebSocketTransport*>(secureWebSocket.get()));
+    QVERIFY(qobject_cast<WebSocketTransport*>(unknown.get()));
+    QVERIFY(qobject_cast<LocalSocketTransport*>(local.get()));
+    QVERIFY(qobject_cast<DirectTransport*>(direct.get()));
+
+    QCOMPARE(LocalSocketTransport::serverNameFromUrl(QUrl("local:seabattle")), QString("seabattle"));
+    QCOMPARE(LocalSocketTransport::serverNameFromUrl(QUrl("local:///tmp/seabattle.sock")), QString("/tmp/seabattle.sock"));
+    QCOMPARE(LocalSocketTransport::serverNameFromUrl(Transport::urlFromString("local://SeaBattle")), QString("SeaBattle"));
+    QCOMPARE(LocalSocketTransport::serverNameFromUrl(Transport::urlFromString("local:///tmp/SeaBattle.sock")),
+             QString("/tmp/SeaBattle.sock"));
+    QCOMPARE(Transport::urlFromString("ws://Localhost:8080"), QUrl("ws://localhost:8080"));
+}
+
+void TestTransport::testLocalFrameEncoding() {
+    const QByteArray frame = LocalSocketTransport::encodeFrame("Ваш ход");
+    const QByteArray payload = QString("Ваш ход").toUtf8();
+    QCOMPARE(frame.size(), payload.size() + 4);
+    QCOMPARE(qFromBigEndian<quint32>(frame.constData()), quint32(payload.size()));
+    QCOMPARE(frame.mid(4), payload);
+}
+
+void TestTransport::testEchoRoundTrip_data() {
+    addTransportRows();
+}
+
+void TestTransport::testEchoRoundTrip() {
+    QFETCH(QString, scheme);
+    EchoServer server(scheme);
+    std::unique_ptr<Transport> client(Transport::create(server.url()));
+    QSignalSpy connected(client.get(), &Transport::connected);
+    QSignalSpy received(client.get(), &Transport::textMessageReceived);
+
+    client->open(server.url());
+    QVERIFY(waitForCount(connected, 1));
+    QVERIFY(client->isConnected());
+
+    client->sendTextMessage("Your turn");
+    client->sendTextMessage(QString());
+    client->sendTextMessage("Shot result: kill");
+    QVERIFY(waitForCount(received, 3));
+    QCOMPARE(received.at(0).at(0).toString(), QString("Your turn"));
+    QCOMPARE(received.at(1).at(0).toString(), QString());
+    QCOMPARE(received.at(2).at(0).toString(), QString("Shot result: kill"));
+    client->close();
+}
+
+void TestTransport::testDirectDisconnect() {
+    DirectTransport first;
+    DirectTransport second;
+    DirectTransport::connectPair(&first, &second);
+    QVERIFY(first.isConnected());
+
+    QSignalSpy disconnected(&second, &Transport::disconnected);
+    first.close();
+    QCOMPARE(disconnected.count(), 1);
+    QVERIFY(!second.isConnected());
+    QCOMPARE(first.sendTextMessage("lost"), qint64(0));
+}
+
+void TestTransport::testDirectMissingServer() {
+    DirectTransport client;
+    QSignalSpy disconnected(&client, &Transport::disconnected);
+    client.open(QUrl("direct://nobody-listens"));
+    QCOMPARE(disconnected.count(), 0);
+    QVERIFY(waitForCount(disconnected, 1));
+    QVERIFY(!client.isConnected());
+}
+
+void TestTransport::testLocalMissingServer() {
+    const QString name = QString("seabattle-missing-%1").arg(QCoreApplication::applicationPid());
+    QLocalServer::removeServer(name);
+    LocalSocketTransport client;
+    QSignalSpy disconnected(&client, &Transport::disconnected);
+    client.open(QUrl(QString("local:%1").arg(name)));
+    QCOMPARE(disconnected.count(), 0);
+    QVERIFY(waitForCount(disconnected, 1));
+    QVERIFY(!client.isConnected());
+    QTest::qWait(100);
+    QCOMPARE(disconnected.count(), 1);
+}
+
+void TestTransport::benchmarkLatency_data() {
+    addTransportRows();
+}
+
+void TestTransport::benchmarkLatency() {
+    QFETCH(QString, scheme);
+    EchoServer server(scheme);
+    std::unique_ptr<Transport> client(Transport::create(server.url()));
+    QSignalSpy connected(client.get(), &Transport::connected);
+    QSignalSpy received(client.get(), &Transport::textMessageReceived);
+    client->open(server.url());
+    QVERIFY(waitForCount(connected, 1));
+
+    QBENCHMARK {
+        const int expected = received.count() + 1;
+        client->sendTextMessage(benchmarkMessage);
+        QVERIFY(waitForCount(received, expected));
+    }
+    client->close();
+}
+
+void TestTransport::benchmarkThroughput_data() {
+    addTransportRows();
+}
+
+void TestTransport::benchmarkThroughput() {
+    QFETCH(QString, scheme);
+    EchoServer server(scheme);
+    std::unique_ptr<Transport> client(Transport::create(server.url()));
+    QSignalSpy connected(client.get(), &Transport::connected);
+    QSignalSpy received(client.get(), &Transport::textMessageReceived);
+    client->open(server.url());
+    QVERIFY(waitForCount(connected, 1));
+
+    QBENCHMARK {
+        received.clear();
+        for (int i = 0; i < throughputMessages; ++i) {
+            client->sendTextMessage(benchmarkMessage);
+        }
+        QVERIFY(waitForCount(received, throughputMessages));
+    }
+    client->close();
+}
+
+QTEST_MAIN(TestTransport)
+#include "test_transport.moc"